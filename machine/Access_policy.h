@@ -0,0 +1,18 @@
+#ifndef MIX_MACHINE_ACCESS_POLICY_H
+#define MIX_MACHINE_ACCESS_POLICY_H
+
+namespace mix
+{
+	// Access policy, selected at build time.
+	// The checked (debug) engine validates every byte index, address and
+	// register number it uses and throws on bad ones. The unchecked
+	// (release) engine, built with MIX_UNCHECKED, skips checks on indices
+	// it already knows are good, and traps bad addresses by faulting the
+	// machine instead of throwing.
+#ifdef MIX_UNCHECKED
+	constexpr bool CHECKED_ACCESS{false};
+#else
+	constexpr bool CHECKED_ACCESS{true};
+#endif
+}
+#endif
@@ -0,0 +1,178 @@
+#ifndef MIX_MACHINE_ARITHMETIC_H
+#define MIX_MACHINE_ARITHMETIC_H
+
+#include "Basic_word.h"
+#include "Sign.h"
+#include "Word.h"
+#include <cstdint>
+#include <type_traits>
+
+namespace mix
+{
+	// Fixed-width arithmetic on packed words.
+	// Intermediates are wide enough to hold the 10-byte rA:rX product
+	// and dividend: 64-bit for binary words, 128-bit for decimal words.
+	// The word size is a compile-time constant, so binary words reduce
+	// with shifts and masks. Nothing allocates or throws.
+
+	// Result of a single word operation.
+	template<typename W>
+	struct Basic_word_result
+	{
+		W value;
+		bool overflow;
+	};
+
+	// Result of a double word (rA:rX) operation.
+	template<typename W>
+	struct Basic_double_word_result
+	{
+		W high;
+		W low;
+		bool overflow;
+	};
+
+	using Word_result = Basic_word_result<Word>;
+	using Double_word_result = Basic_double_word_result<Word>;
+
+	// Unsigned integer holding the magnitude of a double word.
+	template<typename W>
+	using Double_magnitude = std::conditional_t<
+		(W::modulus() <= (std::uint64_t{1} << 32)),
+		std::uint64_t,
+		unsigned __int128
+	>;
+
+	/*
+	* Returns the value of the given word as a signed 64-bit integer.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	w - Word to convert.
+	*/
+	template<unsigned int N, typename M>
+	constexpr std::int64_t signed_value(const Basic_word<N, M>& w)
+	{
+		const std::int64_t magnitude{static_cast<std::int64_t>(w.magnitude())};
+		return w.sign() == Sign::Minus ? -magnitude : magnitude;
+	}
+
+	/*
+	* Add v to a.
+	* If the sum doesn't fit in a word, overflow is set and the value
+	* holds the sum modulo the word size, with the sign of the sum.
+	* A zero sum keeps the sign of a.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	a - Augend, usually rA.
+	*	v - Addend.
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_word_result<Basic_word<N, M>> add(const Basic_word<N, M>& a,
+													  const Basic_word<N, M>& v)
+	{
+		using W = Basic_word<N, M>;
+		const std::int64_t sum{signed_value(a) + signed_value(v)};
+		const std::uint64_t magnitude{
+			static_cast<std::uint64_t>(sum < 0 ? -sum : sum)
+		};
+		Sign s{a.sign()};
+		if (sum != 0)
+			s = (sum < 0 ? Sign::Minus : Sign::Plus);
+		return Basic_word_result<W>{
+			W::from_magnitude(s, magnitude),
+			magnitude >= W::modulus()
+		};
+	}
+
+	/*
+	* Subtract v from a.
+	* Same overflow and sign rules as add().
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	a - Minuend, usually rA.
+	*	v - Subtrahend.
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_word_result<Basic_word<N, M>> subtract(
+			const Basic_word<N, M>& a,
+			const Basic_word<N, M>& v)
+	{
+		Basic_word<N, M> negated{v};
+		negated.negate();
+		return add(a, negated);
+	}
+
+	/*
+	* Multiply a by v, giving a 10-byte product.
+	* Both halves of the product get the sign of the product.
+	* Multiplication never overflows.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	a - Multiplicand, usually rA.
+	*	v - Multiplier.
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_double_word_result<Basic_word<N, M>> multiply(
+			const Basic_word<N, M>& a,
+			const Basic_word<N, M>& v)
+	{
+		using W = Basic_word<N, M>;
+		const Double_magnitude<W> product{
+			static_cast<Double_magnitude<W>>(a.magnitude()) * v.magnitude()
+		};
+		const Double_magnitude<W> modulus{W::modulus()};
+		const Sign s{a.sign() == v.sign() ? Sign::Plus : Sign::Minus};
+		return Basic_double_word_result<W>{
+			W::from_magnitude(s, static_cast<std::uint64_t>(product / modulus)),
+			W::from_magnitude(s, static_cast<std::uint64_t>(product % modulus)),
+			false
+		};
+	}
+
+	/*
+	* Divide the 10-byte dividend high:low by v.
+	* The dividend has the sign of high. The quotient's sign is the sign
+	* of the division, the remainder's sign is the sign of the dividend.
+	* If v is zero, or the quotient doesn't fit in a word, overflow is
+	* set and the dividend is returned unchanged.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	high - Most significant half of the dividend, usually rA.
+	*	low - Least significant half of the dividend, usually rX.
+	*	v - Divisor.
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_double_word_result<Basic_word<N, M>> divide(
+			const Basic_word<N, M>& high,
+			const Basic_word<N, M>& low,
+			const Basic_word<N, M>& v)
+	{
+		using W = Basic_word<N, M>;
+		const std::uint64_t divisor{v.magnitude()};
+		if (divisor <= high.magnitude())
+			return Basic_double_word_result<W>{high, low, true};
+		const Double_magnitude<W> dividend{
+			static_cast<Double_magnitude<W>>(high.magnitude()) * W::modulus()
+			+ low.magnitude()
+		};
+		const Sign s{high.sign() == v.sign() ? Sign::Plus : Sign::Minus};
+		return Basic_double_word_result<W>{
+			W::from_magnitude(s,
+							  static_cast<std::uint64_t>(dividend / divisor)),
+			W::from_magnitude(high.sign(),
+							  static_cast<std::uint64_t>(dividend % divisor)),
+			false
+		};
+	}
+}
+#endif
@@ -1,233 +1,631 @@
 #ifndef MIX_MACHINE_BASIC_WORD_H
 #define MIX_MACHINE_BASIC_WORD_H
 
+#include "Access_policy.h"
 #include "Byte.h"
 #include "Field_spec.h"
 #include "Sign.h"
+#include <array>
+#include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <stdexcept>
-#include <vector>
+#include <type_traits>
 
 namespace mix
 {
 	// Invalid basic word exception.
 	class Invalid_basic_word{};
 
+	/*
+	* Throw the exception for an integer too big for a basic word.
+	* Kept out of line so the word constructors stay constexpr.
+	* Parameters:
+	*	n - Integer value that doesn't fit.
+	*/
+	[[noreturn]] inline void throw_int_too_big(long long n)
+	{
+		std::stringstream message{};
+		message << "In Basic_word(long long), integer is too big: " << n;
+		throw std::invalid_argument{message.str()};
+	}
+
 
 	// A mix basic word.
-	template<unsigned int Num_bytes>
+	// The sign and all bytes are packed into a single 64-bit integer,
+	// where each byte takes a lane of S = Model::size bits:
+	//	[0, N * S)	- Bytes, byte N in the lowest lane.
+	//	N * S		- Sign bit, set when negative.
+	//	N * S + 1	- Invalid sign flag.
+	//	N * S + 2	- Invalid byte flags, one bit per byte,
+	//				  byte N in the lowest bit.
+	// The byte model is fixed at compile time, so masks and radix
+	// arithmetic fold to constants for both binary and decimal words.
+	template<unsigned int Num_bytes, typename Model = Binary_byte>
 	class Basic_word
 	{
 	public:
 		// Number of bytes.
 		static const unsigned int num_bytes = Num_bytes;
 
+		// Byte model.
+		using byte_model = Model;
+
+		// Packed representation.
+		using Packed = std::uint64_t;
+
+		// Writable references to a single byte or the sign.
+		class Byte_reference;
+		class Sign_reference;
+
+		// Precomputed masks and shifts of a field specification.
+		struct Field_masks
+		{
+			// Parts of the field, in place.
+			Packed field;
+			Packed magnitude;
+			Packed flags;
+			Packed sign;
+
+			// Sign bits kept when right aligning.
+			// Field (0:0) right aligns to +0.
+			Packed aligned_sign;
+
+			// Shifts moving the field to the right-most bytes.
+			unsigned char magnitude_right;
+			unsigned char flags_right;
+
+			// Shifts moving the field to the left-most bytes.
+			unsigned char magnitude_left;
+			unsigned char flags_left;
+		};
+
 
 		// Constructors.
-		Basic_word(Sign s = Sign::Plus, std::vector<Byte> vb = {});
-		Basic_word(const Basic_word&);
-		Basic_word(Basic_word&&);
-		Basic_word(int);
+		constexpr Basic_word(Sign s = Sign::Plus,
+							 std::initializer_list<Byte> lb = {});
+		Basic_word(const Basic_word&) = default;
+		Basic_word(Basic_word&&) = default;
+		constexpr Basic_word(long long);
 
 
 		/* Operators. */
 
 		// Assignments.
-		Basic_word& operator=(const Basic_word&);
-		Basic_word& operator=(Basic_word&&);
+		Basic_word& operator=(const Basic_word&) = default;
+		Basic_word& operator=(Basic_word&&) = default;
 
 		// Comparison.
-		bool operator==(const Basic_word&) const;
+		constexpr bool operator==(const Basic_word&) const;
 
 		// Conversion.
 		template<unsigned int N>
-		operator Basic_word<N>() const;
+		constexpr operator Basic_word<N, Model>() const;
 
 
 		/* Functions. */
 
 		// Byte accessors.
-		Byte byte(int) const;
-		Byte& byte(int);
+		constexpr Byte byte(int) const;
+		constexpr Byte_reference byte(int);
 
 		// Sign accessors.
-		Sign sign() const;
-		Sign& sign();
+		constexpr Sign sign() const;
+		constexpr Sign_reference sign();
 
 		// Byte shifting (mutating).
-		void shift_right(int);
-		void shift_left(int);
+		constexpr void shift_right(int);
+		constexpr void shift_left(int);
 
 		// Byte shifted (non-mutating).
-		Basic_word shifted_right(int) const;
-		Basic_word shifted_left(int) const;
+		constexpr Basic_word shifted_right(int) const;
+		constexpr Basic_word shifted_left(int) const;
 
 		// Rotating shifts.
-		void rotate_right(int);
-		void rotate_left(int);
+		constexpr void rotate_right(int);
+		constexpr void rotate_left(int);
+
+		// Shifts across a pair of words, the first holding the left bytes.
+		static constexpr void shift_pair_left(Basic_word&, Basic_word&, int);
+		static constexpr void shift_pair_right(Basic_word&, Basic_word&, int);
+		static constexpr void rotate_pair_left(Basic_word&, Basic_word&, int);
+		static constexpr void rotate_pair_right(Basic_word&, Basic_word&, int);
 
 		// Clear all bytes.
-		void clear();
-		void clear_bytes();
+		constexpr void clear();
+		constexpr void clear_bytes();
 
 		// Range copy.
-		void copy_range(const Basic_word&, int fist = 0, int last = Num_bytes);
-		void copy_range(const Basic_word&, const Field_spec&);
+		constexpr void copy_range(const Basic_word&,
+								  int fist = 0, int last = Num_bytes);
+		constexpr void copy_range(const Basic_word&, const Field_spec&);
+
+		// Write right-most bytes of a word into a field of this word.
+		constexpr void insert_field(const Basic_word&, const Field_spec&);
 
 		// Basic word validity check.
-		bool is_valid() const;
+		constexpr bool is_valid() const;
 
-		// Converting contiguous ranges to integer.
-		int to_int(int first = 0, int last = Num_bytes) const;
-		int to_int(const Field_spec&) const;
+		// Converting contiguous ranges to integer. Every value fits
+		// in a long long, whatever the byte model.
+		constexpr long long to_int(int first = 0, int last = Num_bytes) const;
+		constexpr long long to_int(const Field_spec&) const;
 
 		// Negate the sign.
-		Basic_word& negate();
+		constexpr Basic_word& negate();
 
 		// Field alignment.
-		Basic_word field_aligned_left(const Field_spec&) const;
-		Basic_word field_aligned_right(const Field_spec&) const;
+		constexpr Basic_word field_aligned_left(const Field_spec&) const;
+		constexpr Basic_word field_aligned_right(const Field_spec&) const;
 
 		// Left/right most bytes only.
-		Basic_word leftmost_bytes(int) const;
-		Basic_word rightmost_bytes(int) const;
-		Basic_word leftmost_with_sign(int) const;
-		Basic_word rightmost_with_sign(int) const;
+		constexpr Basic_word leftmost_bytes(int) const;
+		constexpr Basic_word rightmost_bytes(int) const;
+		constexpr Basic_word leftmost_with_sign(int) const;
+		constexpr Basic_word rightmost_with_sign(int) const;
+
+		static constexpr long long int_max();
+		static constexpr long long int_min();
+
+		// Number of distinct magnitudes, radix to the power of N.
+		static constexpr std::uint64_t modulus();
 
-		static int int_max();
-		static int int_min();
+		// Packed representation access.
+		constexpr Packed packed() const { return bits; }
+		static constexpr Basic_word from_packed(Packed);
+		static constexpr bool is_packed(Packed);
+
+		// Magnitude access, as an integer.
+		constexpr Packed magnitude() const;
+		static constexpr Basic_word from_magnitude(Sign, Packed);
+
+		// Field masks lookup.
+		static constexpr const Field_masks& field_masks(const Field_spec&);
 
 
 	private:
+		// Layout of the packed representation.
+		static const unsigned int magnitude_bits = Num_bytes * Model::size;
+		static const unsigned int sign_bit = magnitude_bits;
+		static const unsigned int invalid_sign_bit = magnitude_bits + 1;
+		static const unsigned int invalid_bytes_shift = magnitude_bits + 2;
+
+		static_assert(invalid_bytes_shift + Num_bytes <= 64,
+					  "Basic word does not fit in packed representation");
+
+		// Bytes of a pair of words, as a single integer.
+		using Pair_lanes = std::conditional_t<
+			(2 * magnitude_bits <= 64), Packed, unsigned __int128>;
+
 		// Implementation.
-		Sign sign_byte;
-		std::vector<Byte> bytes;
+		Packed bits;
+
+		// Number of encoded field specifications.
+		static const unsigned int num_fields =
+			Field_spec::ENCODE_VALUE * (Num_bytes + 1);
 
 
 		// Helper functions.
-		void check_byte_index(int) const;
-		void check_range(int, int) const;
-		void check_rotate_amount(int&) const;
-		void rotate_bytes_right(int);
+		constexpr void check_byte_index(int) const;
+		static constexpr void check_range(int, int);
+		constexpr void check_rotate_amount(int&) const;
+		constexpr void rotate_bytes_right(int);
+		static constexpr Pair_lanes pair_lanes(const Basic_word&,
+											   const Basic_word&);
+		static constexpr Packed pair_flags(const Basic_word&,
+										   const Basic_word&);
+		static constexpr void split_pair(Basic_word&, Basic_word&,
+										 Pair_lanes, Packed);
+		constexpr void set_byte(int, Byte);
+		constexpr void set_sign(Sign);
+
+		// Packed layout helpers.
+		static constexpr Packed magnitude_mask();
+		static constexpr Packed flags_mask();
+		static constexpr Packed lanes_mask(int, int, int);
+		static constexpr Packed magnitude_range(int, int);
+		static constexpr Packed flags_range(int, int);
+		static constexpr Packed sign_bits();
+		static constexpr int byte_shift(int);
+		static constexpr Packed lanes_to_value(Packed);
+		static constexpr Packed value_to_lanes(Packed);
+		static constexpr Field_masks make_field_masks(int, int);
+		static constexpr std::array<Field_masks, num_fields> make_field_table();
+
+		// Field masks, indexed by encoded field specification.
+		static constexpr std::array<Field_masks, num_fields> field_table{
+			make_field_table()
+		};
 	};
 
 
-	/*** Constructors and destructor. ***/
+	/*
+	* Reference to a single byte of a basic word.
+	* Reads and writes go through the packed representation.
+	*/
+	template<unsigned int N, typename M>
+	class Basic_word<N, M>::Byte_reference
+	{
+	public:
+		constexpr Byte_reference(Basic_word& bw, int i)
+			: word(bw), index{i} {}
+
+		constexpr operator Byte() const
+		{
+			return static_cast<const Basic_word&>(word).byte(index);
+		}
+
+		constexpr Byte_reference& operator=(Byte b)
+		{
+			word.set_byte(index, b);
+			return *this;
+		}
+
+		constexpr Byte_reference& operator=(const Byte_reference& br)
+		{
+			return *this = static_cast<Byte>(br);
+		}
+
+	private:
+		Basic_word& word;
+		int index;
+	};
 
 	/*
-	* Fully parameterized constructor.
+	* Reference to the sign of a basic word.
+	*/
+	template<unsigned int N, typename M>
+	class Basic_word<N, M>::Sign_reference
+	{
+	public:
+		constexpr explicit Sign_reference(Basic_word& bw) : word(bw) {}
+
+		constexpr operator Sign() const
+		{
+			return static_cast<const Basic_word&>(word).sign();
+		}
+
+		constexpr Sign_reference& operator=(Sign s)
+		{
+			word.set_sign(s);
+			return *this;
+		}
+
+		constexpr Sign_reference& operator=(const Sign_reference& sr)
+		{
+			return *this = static_cast<Sign>(sr);
+		}
+
+		constexpr bool operator==(Sign s) const
+		{
+			return static_cast<Sign>(*this) == s;
+		}
+
+		constexpr bool operator!=(Sign s) const { return !(*this == s); }
+
+	private:
+		Basic_word& word;
+	};
+
+
+	/*** Packed layout helpers. ***/
+
+	/*
+	* Returns the mask of all magnitude bits.
 	* Template parameters:
 	*	N - Number of bytes.
-	* Parameters:
-	*	s - Sign.
-	*	byte_vec - Bytes.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	Basic_word<N>::Basic_word(Sign s, std::vector<Byte> byte_vec)
-		: sign_byte{s}, bytes{}
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::magnitude_mask()
 	{
-		if (byte_vec.size() > num_bytes)
-			throw std::invalid_argument{"Too many bytes in initializer list."};
-		for (auto p = byte_vec.begin(); p != byte_vec.end(); ++p)
-			bytes.push_back(*p);
-		while (bytes.size() < num_bytes)
-			bytes.push_back(0);
+		return (Packed{1} << magnitude_bits) - 1;
 	}
 
 	/*
-	* Construct a basic word by copying the given basic word.
+	* Returns the mask of all invalid byte flags.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed Basic_word<N, M>::flags_mask()
+	{
+		return ((Packed{1} << N) - 1) << invalid_bytes_shift;
+	}
+
+	/*
+	* Returns the mask of the bytes [first, last], where each byte
+	* occupies a lane of the given width, byte N in the lowest lane.
 	* Parameters:
-	*	bw - Basic word.
+	*	first - First byte in range, in range [1, N].
+	*	last - Last byte in range, in range [first, N].
+	*	width - Width of a lane in bits.
 	*/
-	template<unsigned int N>
-	Basic_word<N>::Basic_word(const Basic_word& bw)
-		: sign_byte{bw.sign_byte}, bytes{bw.bytes}
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed Basic_word<N, M>::lanes_mask(
+			int first,
+			int last,
+			int width)
 	{
+		if (first > last) return 0;
+		Packed lanes{(Packed{1} << (width * (last - first + 1))) - 1};
+		return lanes << (width * (static_cast<int>(N) - last));
 	}
 
 	/*
-	* Construct a basic word by moving the given basic word.
+	* Returns the magnitude bits of the bytes [first, last].
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::magnitude_range(
+			int first,
+			int last)
+	{
+		return lanes_mask(first, last, M::size);
+	}
+
+	/*
+	* Returns the invalid flags of the bytes [first, last].
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed Basic_word<N, M>::flags_range(
+			int first,
+			int last)
+	{
+		return lanes_mask(first, last, 1) << invalid_bytes_shift;
+	}
+
+	/*
+	* Returns the mask of the sign bit and the invalid sign flag.
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed Basic_word<N, M>::sign_bits()
+	{
+		return (Packed{1} << sign_bit) | (Packed{1} << invalid_sign_bit);
+	}
+
+	/*
+	* Returns the position of the lowest bit of the byte at the given index.
+	* Parameters:
+	*	index - Byte index, in range [1, N].
+	*/
+	template<unsigned int N, typename M>
+	constexpr int Basic_word<N, M>::byte_shift(int index)
+	{
+		return M::size * (static_cast<int>(N) - index);
+	}
+
+	/*
+	* Returns the integer value of the given byte lanes.
+	* Binary bytes fill their lanes, so the lanes are the value.
+	* Parameters:
+	*	lanes - Bytes, byte N in the lowest lane.
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::lanes_to_value(Packed lanes)
+	{
+		if constexpr (M::binary) {
+			return lanes;
+		}
+		else {
+			Packed value{0};
+			for (int i = 1; i <= static_cast<int>(N); ++i)
+				value = value * M::radix + ((lanes >> byte_shift(i)) & M::mask);
+			return value;
+		}
+	}
+
+	/*
+	* Returns the byte lanes of the given integer value.
+	* Parameters:
+	*	value - Integer value, in range [0, modulus()).
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::value_to_lanes(Packed value)
+	{
+		if constexpr (M::binary) {
+			return value;
+		}
+		else {
+			Packed lanes{0};
+			for (int i = static_cast<int>(N); i >= 1; --i) {
+				lanes |= (value % M::radix) << byte_shift(i);
+				value /= M::radix;
+			}
+			return lanes;
+		}
+	}
+
+	/*
+	* Compute the masks and shifts of the field (left:right).
+	* Parameters:
+	*	left - Left of field, in range [0, N].
+	*	right - Right of field, in range [left, N].
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Field_masks
+	Basic_word<N, M>::make_field_masks(int left, int right)
+	{
+		const int first{left == 0 ? 1 : left};
+		const int right_amount{static_cast<int>(N) - right};
+		const int left_amount{first - 1};
+		const Packed sign{left == 0 ? sign_bits() : 0};
+		Field_masks m{};
+		m.magnitude = magnitude_range(first, right);
+		m.flags = flags_range(first, right);
+		m.sign = sign;
+		m.field = m.magnitude | m.flags | m.sign;
+		m.aligned_sign = (right == 0 ? 0 : sign);
+		m.magnitude_right = static_cast<unsigned char>(M::size * right_amount);
+		m.flags_right = static_cast<unsigned char>(right_amount);
+		m.magnitude_left = static_cast<unsigned char>(M::size * left_amount);
+		m.flags_left = static_cast<unsigned char>(left_amount);
+		return m;
+	}
+
+	/*
+	* Compute the field masks of every valid field specification.
+	* Entries of invalid field specifications are left empty.
+	*/
+	template<unsigned int N, typename M>
+	constexpr std::array<typename Basic_word<N, M>::Field_masks,
+						 Basic_word<N, M>::num_fields>
+	Basic_word<N, M>::make_field_table()
+	{
+		std::array<Field_masks, num_fields> table{};
+		for (int left = 0; left <= static_cast<int>(N); ++left) {
+			for (int right = left; right <= static_cast<int>(N); ++right) {
+				const int encoded{left * Field_spec::ENCODE_VALUE + right};
+				table[encoded] = make_field_masks(left, right);
+			}
+		}
+		return table;
+	}
+
+	/*
+	* Returns the masks of the given field specification.
+	* If the field is out of range for this basic word, throws an exception.
+	* Parameters:
+	*	field - Field specification.
+	*/
+	template<unsigned int N, typename M>
+	constexpr const typename Basic_word<N, M>::Field_masks&
+	Basic_word<N, M>::field_masks(const Field_spec& field)
+	{
+		check_range(field.left, field.right);
+		return field_table[field.encode()];
+	}
+
+
+	/*** Constructors and destructor. ***/
+
+	/*
+	* Fully parameterized constructor.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	* Parameters:
-	*	bw - Basic word.
+	*	s - Sign.
+	*	byte_list - Bytes, left-most first. Missing bytes are 0.
 	*/
-	template<unsigned int N>
-	Basic_word<N>::Basic_word(Basic_word&& bw)
-		: sign_byte{bw.sign_byte}, bytes{std::move(bw.bytes)}
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>::Basic_word(Sign s,
+										std::initializer_list<Byte> byte_list)
+		: bits{0}
 	{
+		if (byte_list.size() > num_bytes)
+			throw std::invalid_argument{"Too many bytes in initializer list."};
+		set_sign(s);
+		int index{1};
+		for (auto p = byte_list.begin(); p != byte_list.end(); ++p)
+			set_byte(index++, *p);
 	}
 
 	/*
 	* Construct from the given integer.
 	* Template parameters:
 	*	N - Number of bytes of this given word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Integer value to construct a basic word from.
 	*/
-	template<unsigned int N>
-	Basic_word<N>::Basic_word(int n)
-		: sign_byte{Sign::Plus}, bytes(N)
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>::Basic_word(long long n)
+		: bits{0}
 	{
-		if (std::abs(n) > int_max()) {
-			std::stringstream message{};
-			message << "In Basic_word(int), int is too big: " << n;
-			throw std::invalid_argument{message.str()};
+		// Negated unsigned, since -n overflows for the smallest integer.
+		const Packed magnitude{
+			n < 0 ? Packed{0} - static_cast<Packed>(n) : static_cast<Packed>(n)
+		};
+		if (magnitude >= modulus()) {
+			throw_int_too_big(n);
 		}
+		bits = value_to_lanes(magnitude);
 		if (n < 0) {
-			sign() = Sign::Minus;
-		}
-		// Convert from base-10 to basic word base.
-		int base{static_cast<int>(std::pow(2, BYTE_SIZE))};
-		int index{N};
-		int val{std::abs(n)};
-		while (val > 0) {
-			Byte b = static_cast<Byte>(val % base);
-			byte(index--) = b;
-			val /= base;
+			bits |= Packed{1} << sign_bit;
 		}
 	}
 
-
-	/*** Operators. ***/
-
-
-	/* Assignments. */
+	/*
+	* Construct a basic word from its packed representation.
+	* Parameters:
+	*	p - Packed representation, as returned by packed().
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M> Basic_word<N, M>::from_packed(Packed p)
+	{
+		Basic_word<N, M> bw{};
+		bw.bits = p;
+		return bw;
+	}
 
 	/*
-	* Copy assignment.
+	* Returns whether the given integer is the packed representation of
+	* a basic word: it sets no bit outside the layout, and each byte
+	* lane holds a value of the byte model.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	* Parameters:
-	*	bw - Basic word to copy assign.
+	*	p - Integer to check.
 	*/
-	template<unsigned int N>
-	Basic_word<N>& Basic_word<N>::operator=(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr bool Basic_word<N, M>::is_packed(Packed p)
 	{
-		sign_byte = bw.sign_byte;
-		bytes = bw.bytes;
-		return *this;
+		const Packed layout{
+			flags_mask() | ((Packed{1} << invalid_bytes_shift) - 1)
+		};
+		if (p & ~layout)
+			return false;
+		if (M::binary)
+			return true;
+		for (int i = 1; i <= static_cast<int>(N); ++i) {
+			if (((p >> byte_shift(i)) & M::mask) >= M::radix)
+				return false;
+		}
+		return true;
 	}
 
 	/*
-	* Move assignment.
+	* Construct a basic word from a sign and a magnitude.
+	* The magnitude is taken modulo the word size, dropping the
+	* digits that don't fit in N bytes.
+	* Parameters:
+	*	s - Sign.
+	*	magnitude - Magnitude, as an integer.
+	*/
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>
+	Basic_word<N, M>::from_magnitude(Sign s, Packed magnitude)
+	{
+		Basic_word<N, M> bw{s};
+		bw.bits |= value_to_lanes(magnitude % modulus());
+		return bw;
+	}
+
+	/*
+	* Returns the magnitude of this basic word, as an integer.
 	* Template parameters:
 	*	N - Number of bytes.
-	* Parameters:
-	*	bw - Basic word to move assign.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	Basic_word<N>& Basic_word<N>::operator=(Basic_word<N>&& bw)
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::magnitude() const
 	{
-		sign_byte = bw.sign_byte;
-		bytes = std::move(bw.bytes);
-		return *this;
+		return lanes_to_value(bits & magnitude_mask());
 	}
 
 
+	/*** Operators. ***/
+
+
 	/* Conversion. */
 
 	/*
@@ -237,17 +635,21 @@ namespace mix
 	* Template parameters:
 	*	N1 - Number of bytes of the basic word to be converted.
 	*	N2 - Number of bytes of the new basic word.
+	*	M - Byte model of both words.
 	*/
-	template<unsigned int N1>
+	template<unsigned int N1, typename M>
 	template<unsigned int N2>
-	Basic_word<N1>::operator Basic_word<N2>() const
+	constexpr Basic_word<N1, M>::operator Basic_word<N2, M>() const
 	{
-		Basic_word<N2> bw{};
-		bw.sign() = sign_byte;
-		for (int i = N1, j = N2; i > 0 && j > 0; --i, --j) {
-			bw.byte(j) = byte(i);
-		}
-		return bw;
+		// Right-most bytes keep their position, so only the masks differ.
+		const unsigned int kept{N1 < N2 ? N1 : N2};
+		const Packed kept_bytes{(Packed{1} << (kept * M::size)) - 1};
+		const Packed kept_flags{(Packed{1} << kept) - 1};
+		Packed p{bits & kept_bytes};
+		p |= ((bits >> sign_bit) & 3) << (N2 * M::size);
+		p |= ((bits >> invalid_bytes_shift) & kept_flags)
+				<< (N2 * M::size + 2);
+		return Basic_word<N2, M>::from_packed(p);
 	}
 
 
@@ -257,16 +659,14 @@ namespace mix
 	* Tests two basic words for equality.
 	* Template parameters:
 	*	N - Number of bytes of both words.
+	*	M - Byte model.
 	* Parameters:
 	*	bw - Word to compare to.
 	*/
-	template<unsigned int N>
-	bool Basic_word<N>::operator==(const Basic_word& bw) const
+	template<unsigned int N, typename M>
+	constexpr bool Basic_word<N, M>::operator==(const Basic_word& bw) const
 	{
-		if (sign_byte == bw.sign_byte) {
-			return bytes == bw.bytes;
-		}
-		return false;
+		return bits == bw.bits;
 	}
 
 
@@ -279,22 +679,27 @@ namespace mix
 	* Parameters:
 	*	index - Index of the byte to return, in range [1, N].
 	*/
-	template<unsigned int N>
-	Byte Basic_word<N>::byte(int index) const
+	template<unsigned int N, typename M>
+	constexpr Byte Basic_word<N, M>::byte(int index) const
 	{
 		check_byte_index(index);
-		return bytes[index - 1];
+		if (bits & flags_range(index, index))
+			return INVALID_BYTE;
+		return static_cast<Byte>((bits >> byte_shift(index)) & M::mask);
 	}
 
 	/*
 	* Checks if the given index is in range [1, N].
-	* If not, throws an exception.
+	* If not, throws an exception. Skipped by the unchecked engine.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::check_byte_index(int index) const
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::check_byte_index(int index) const
 	{
+		if (!CHECKED_ACCESS)
+			return;
 		if (index == 0)
 			throw std::invalid_argument{"Cannot access sign with byte()"};
 		if (index < 1 || num_bytes < index)
@@ -302,115 +707,159 @@ namespace mix
 	}
 
 	/*
-	* Returns the byte at the given index.
+	* Returns a reference to the byte at the given index.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	* Parameters:
 	*	index - Index of the byte to return, in range [1, N].
 	*/
-	template<unsigned int N>
-	Byte& Basic_word<N>::byte(int index)
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Byte_reference
+	Basic_word<N, M>::byte(int index)
 	{
 		check_byte_index(index);
-		return bytes[index - 1];
+		return Byte_reference{*this, index};
 	}
 
-	
+	/*
+	* Write the given byte at the given index.
+	* Bytes above the byte model's maximum are marked invalid.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	index - Index of the byte to write, in range [1, N].
+	*	b - Byte to write.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::set_byte(int index, Byte b)
+	{
+		bits &= ~(magnitude_range(index, index) | flags_range(index, index));
+		if (b > M::max)
+			bits |= flags_range(index, index);
+		else
+			bits |= static_cast<Packed>(b) << byte_shift(index);
+	}
+
+
 	/* Sign accessors. */
 
 	/*
 	* Returns the sign of the basic word.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	Sign Basic_word<N>::sign() const
+	template<unsigned int N, typename M>
+	constexpr Sign Basic_word<N, M>::sign() const
 	{
-		return sign_byte;
+		if (bits & (Packed{1} << invalid_sign_bit))
+			return Sign::Invalid;
+		return (bits & (Packed{1} << sign_bit)) ? Sign::Minus : Sign::Plus;
 	}
 
 	/*
-	* Returns the sign of the basic word.
+	* Returns a reference to the sign of the basic word.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	Sign& Basic_word<N>::sign()
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Sign_reference Basic_word<N, M>::sign()
 	{
-		return sign_byte;
+		return Sign_reference{*this};
+	}
+
+	/*
+	* Write the given sign.
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	s - Sign to write.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::set_sign(Sign s)
+	{
+		bits &= ~sign_bits();
+		if (s == Sign::Minus)
+			bits |= Packed{1} << sign_bit;
+		else if (s != Sign::Plus)
+			bits |= Packed{1} << invalid_sign_bit;
 	}
 
 	/*
 	* Shift bytes right by the given amount.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Number of times to shift right.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::shift_right(int n)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::shift_right(int n)
 	{
-		if (n > N) clear_bytes();
 		if (n < 0)
 			throw std::invalid_argument{"Cannot shift by negative amount"};
+		if (n >= static_cast<int>(N)) {
+			clear_bytes();
+			return;
+		}
 
-		// Move bytes that will not be shifted out.
-		int i = N;
-		for (int j = N - n; j > 0; --i, --j)
-			byte(i) = byte(j);
-
-		// Left-fill with 0s.
-		for (int j = 1; j <= i; ++j)
-			byte(j) = 0;
+		// Bytes and their invalid flags move together, left-filling with 0s.
+		Packed magnitude{(bits & magnitude_mask()) >> (n * M::size)};
+		Packed flags{((bits & flags_mask()) >> n) & flags_mask()};
+		bits = (bits & sign_bits()) | magnitude | flags;
 	}
 
 	/*
 	* Clear the word to +0.
 	* Template parameters:
 	*	N - Number of bytes in the word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::clear()
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::clear()
 	{
-		sign_byte = Sign::Plus;
-		clear_bytes();
+		bits = 0;
 	}
 
 	/*
 	* Clear all bytes to 0.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::clear_bytes()
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::clear_bytes()
 	{
-		for (int i = 1; i <= num_bytes; ++i) {
-			byte(i) = 0;
-		}
+		bits &= sign_bits();
 	}
 
 	/*
 	* Shift bytes left, right-filling with 0s.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Number of times to left shift.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::shift_left(int n)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::shift_left(int n)
 	{
-		if (n > N) clear_bytes();
 		if (n < 0)
 			throw std::invalid_argument{"Cannot shift by negative amount"};
+		if (n >= static_cast<int>(N)) {
+			clear_bytes();
+			return;
+		}
 
-		// Move bytes that will not be shifted out.
-		int i = 1;
-		for (int j = 1 + n; j <= N; ++i, ++j)
-			byte(i) = byte(j);
-
-		// Right fill with 0s.
-		for (int j = N; j >= i; --j)
-			byte(j) = 0;
+		// Bytes and their invalid flags move together, right-filling with 0s.
+		Packed magnitude{((bits & magnitude_mask()) << (n * M::size))
+						 & magnitude_mask()};
+		Packed flags{((bits & flags_mask()) << n) & flags_mask()};
+		bits = (bits & sign_bits()) | magnitude | flags;
 	}
 
 	/*
@@ -418,13 +867,14 @@ namespace mix
 	* by the given amount.
 	* Template parameters:
 	*	N - Number of bytes of this basic word, and the returned word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - The amount the returned word will be shifted.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::shifted_right(int n) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M> Basic_word<N, M>::shifted_right(int n) const
 	{
-		Basic_word<N> copy{*this};
+		Basic_word<N, M> copy{*this};
 		copy.shift_right(n);
 		return copy;
 	}
@@ -434,13 +884,14 @@ namespace mix
 	* by the given amount.
 	* Template parameters:
 	*	N - Number of bytes of this basic word, and the returned word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - The amount the returned word will be shifted.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::shifted_left(int n) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M> Basic_word<N, M>::shifted_left(int n) const
 	{
-		Basic_word<N> copy{*this};
+		Basic_word<N, M> copy{*this};
 		copy.shift_left(n);
 		return copy;
 	}
@@ -449,11 +900,12 @@ namespace mix
 	* Rotate shift right all bytes n times.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Number of times to rotate right.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::rotate_right(int n)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::rotate_right(int n)
 	{
 		check_rotate_amount(n);
 		rotate_bytes_right(n);
@@ -465,11 +917,12 @@ namespace mix
 	* Normalizes amount to be within range [0, N - 1].
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Amount to rotate by.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::check_rotate_amount(int& n) const
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::check_rotate_amount(int& n) const
 	{
 		if (n < 0)
 			throw std::invalid_argument{"Cannot rotate negative amount"};
@@ -480,65 +933,231 @@ namespace mix
 	* Rotate bytes right by the given amount.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
-	*	n - Number of times to rotate right.
+	*	n - Number of times to rotate right, in range [0, N].
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::rotate_bytes_right(int n)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::rotate_bytes_right(int n)
 	{
-		if (n == 0) return;
-
-		// Rotate bytes.
-		std::vector<Byte> copy{bytes};
-		for (int i = 0, j = n; i < N; ++i) {
-			bytes[j] = copy[i];
-			j = (j + 1) % N;
-		}
+		if (n == 0 || n == static_cast<int>(N)) return;
+
+		// Rotate bytes, then their invalid flags, within their own fields.
+		const int rest{static_cast<int>(N) - n};
+		Packed magnitude{bits & magnitude_mask()};
+		magnitude = ((magnitude >> (n * M::size))
+					 | (magnitude << (rest * M::size))) & magnitude_mask();
+		Packed flags{(bits & flags_mask()) >> invalid_bytes_shift};
+		flags = ((flags >> n) | (flags << rest)) & ((Packed{1} << N) - 1);
+		bits = (bits & sign_bits()) | magnitude
+				| (flags << invalid_bytes_shift);
 	}
 
 	/*
 	* Rotate shift left all bytes n times.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	n - Number of times to rotate left.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::rotate_left(int n)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::rotate_left(int n)
 	{
 		// Rotating left by n is the same as rotating right by N - n.
 		check_rotate_amount(n);
 		rotate_bytes_right(N - n);
 	}
 
+	/*
+	* Shift the bytes of a pair of words left, right-filling with 0s.
+	* The pair is shifted as a single integer; signs are unchanged.
+	* Template parameters:
+	*	N - Number of bytes of each word.
+	*	M - Byte model.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*	n - Number of bytes to shift by.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::shift_pair_left(Basic_word& left,
+													 Basic_word& right,
+													 int n)
+	{
+		if (n < 0)
+			throw std::invalid_argument{"Cannot shift by negative amount"};
+		const int width{static_cast<int>(2 * N)};
+		const int amount{n < width ? n : width};
+		split_pair(left, right,
+				   pair_lanes(left, right) << (amount * M::size),
+				   pair_flags(left, right) << amount);
+	}
+
+	/*
+	* Shift the bytes of a pair of words right, left-filling with 0s.
+	* The pair is shifted as a single integer; signs are unchanged.
+	* Template parameters:
+	*	N - Number of bytes of each word.
+	*	M - Byte model.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*	n - Number of bytes to shift by.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::shift_pair_right(Basic_word& left,
+													  Basic_word& right,
+													  int n)
+	{
+		if (n < 0)
+			throw std::invalid_argument{"Cannot shift by negative amount"};
+		const int width{static_cast<int>(2 * N)};
+		const int amount{n < width ? n : width};
+		split_pair(left, right,
+				   pair_lanes(left, right) >> (amount * M::size),
+				   pair_flags(left, right) >> amount);
+	}
+
+	/*
+	* Rotate the bytes of a pair of words right.
+	* The pair is rotated as a single integer; signs are unchanged.
+	* Template parameters:
+	*	N - Number of bytes of each word.
+	*	M - Byte model.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*	n - Number of bytes to rotate by.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::rotate_pair_right(Basic_word& left,
+													   Basic_word& right,
+													   int n)
+	{
+		if (n < 0)
+			throw std::invalid_argument{"Cannot rotate negative amount"};
+		const int amount{n % static_cast<int>(2 * N)};
+		if (amount == 0) return;
+		const int rest{static_cast<int>(2 * N) - amount};
+		const Pair_lanes lanes{pair_lanes(left, right)};
+		const Packed flags{pair_flags(left, right)};
+		split_pair(left, right,
+				   (lanes >> (amount * M::size)) | (lanes << (rest * M::size)),
+				   (flags >> amount) | (flags << rest));
+	}
+
+	/*
+	* Rotate the bytes of a pair of words left.
+	* Template parameters:
+	*	N - Number of bytes of each word.
+	*	M - Byte model.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*	n - Number of bytes to rotate by.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::rotate_pair_left(Basic_word& left,
+													  Basic_word& right,
+													  int n)
+	{
+		// Rotating left by n is the same as rotating right by 2N - n.
+		if (n < 0)
+			throw std::invalid_argument{"Cannot rotate negative amount"};
+		const int amount{n % static_cast<int>(2 * N)};
+		rotate_pair_right(left, right, static_cast<int>(2 * N) - amount);
+	}
+
+	/*
+	* Returns the bytes of a pair of words as a single integer,
+	* the left word in the high lanes.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Pair_lanes
+	Basic_word<N, M>::pair_lanes(const Basic_word& left,
+								 const Basic_word& right)
+	{
+		return (static_cast<Pair_lanes>(left.bits & magnitude_mask())
+					<< magnitude_bits)
+			   | (right.bits & magnitude_mask());
+	}
+
+	/*
+	* Returns the invalid byte flags of a pair of words, one bit per byte,
+	* the left word in the high bits.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*/
+	template<unsigned int N, typename M>
+	constexpr typename Basic_word<N, M>::Packed
+	Basic_word<N, M>::pair_flags(const Basic_word& left,
+								 const Basic_word& right)
+	{
+		return (((left.bits & flags_mask()) >> invalid_bytes_shift) << N)
+			   | ((right.bits & flags_mask()) >> invalid_bytes_shift);
+	}
+
+	/*
+	* Write the bytes of a pair of words back, keeping their signs.
+	* Bits above the pair are dropped.
+	* Parameters:
+	*	left - Word holding the left-most bytes of the pair.
+	*	right - Word holding the right-most bytes of the pair.
+	*	lanes - Bytes of the pair, as returned by pair_lanes().
+	*	flags - Invalid flags of the pair, as returned by pair_flags().
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::split_pair(Basic_word& left,
+												Basic_word& right,
+												Pair_lanes lanes,
+												Packed flags)
+	{
+		const Packed word_flags{(Packed{1} << N) - 1};
+		left.bits = (left.bits & sign_bits())
+			| (static_cast<Packed>(lanes >> magnitude_bits) & magnitude_mask())
+			| (((flags >> N) & word_flags) << invalid_bytes_shift);
+		right.bits = (right.bits & sign_bits())
+			| (static_cast<Packed>(lanes) & magnitude_mask())
+			| ((flags & word_flags) << invalid_bytes_shift);
+	}
+
 	/*
 	* Copies the given range [first, last] from the given word
 	* into the same range of this word.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	* Parameters:
 	*	bw - Word to be copied.
 	*	first - First (lowest index) byte to be copied.
 				If 0, the sign is copied.
 	*	last - Last (highest index) byte to be copied.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::copy_range(const Basic_word& bw, int first, int last)
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::copy_range(const Basic_word& bw,
+											 int first,
+											 int last)
 	{
 		check_range(first, last);
+		Packed mask{};
 		if (first == 0) {
-			sign_byte = bw.sign_byte;
+			mask |= sign_bits();
 			++first;
 		}
-		for (int i = first; i <= last; ++i)
-			byte(i) = bw.byte(i);
+		mask |= magnitude_range(first, last) | flags_range(first, last);
+		bits = (bits & ~mask) | (bw.bits & mask);
 	}
 
 	/*
 	* Makes sure the range [first, last] is valid.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::check_range(int first, int last) const
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::check_range(int first, int last)
 	{
 		if (first > last)
 			throw std::invalid_argument{"Invalid range: first > last"};
@@ -553,56 +1172,78 @@ namespace mix
 	* into the same range of this word.
 	* Template parameters:
 	*	N - Number of bytes.
+	*	M - Byte model.
 	* Parameters:
 	*	bw - Word to be copied.
 	*	first - First (lowest index) byte to be copied.
 				If 0, the sign is copied.
 	*	last - Last (highest index) byte to be copied.
 	*/
-	template<unsigned int N>
-	void Basic_word<N>::copy_range(const Basic_word& bw,
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::copy_range(const Basic_word& bw,
 								   const Field_spec& field)
 	{
-		copy_range(bw, field.left, field.right);
+		const Packed mask{field_masks(field).field};
+		bits = (bits & ~mask) | (bw.bits & mask);
+	}
+
+	/*
+	* Writes the right-most bytes of the given word into the range
+	* of the given field spec of this word. If the field contains
+	* the sign, the sign is written too. This is the inverse of
+	* field_aligned_right().
+	* Template parameters:
+	*	N - Number of bytes.
+	*	M - Byte model.
+	* Parameters:
+	*	bw - Word whose right-most bytes are written.
+	*	field - Field of this word to write.
+	*/
+	template<unsigned int N, typename M>
+	constexpr void Basic_word<N, M>::insert_field(const Basic_word& bw,
+									 const Field_spec& field)
+	{
+		const Field_masks& m{field_masks(field)};
+		const Packed inserted{
+			(((bw.bits & magnitude_mask()) << m.magnitude_right) & m.magnitude)
+			| (((bw.bits & flags_mask()) << m.flags_right) & m.flags)
+			| (bw.bits & m.sign)
+		};
+		bits = (bits & ~m.field) | inserted;
 	}
 
 	/*
 	* Checks if the basic word is valid.
+	* A word is valid if neither its sign nor any of its bytes
+	* are marked invalid.
 	* Template paramters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	bool Basic_word<N>::is_valid() const
+	template<unsigned int N, typename M>
+	constexpr bool Basic_word<N, M>::is_valid() const
 	{
-		if (sign_byte == Sign::Invalid)
-			return false;
-
-		for (int i = 1; i <= N; ++i) {
-			if (bytes[i] == INVALID_BYTE || bytes[i] > BYTE_MAX)
-				return false;
-		}
-		return true;
+		return (bits & ((Packed{1} << invalid_sign_bit) | flags_mask())) == 0;
 	}
 
 	/*
 	* Reads a range of bytes as an integer
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	first - First byte in range.
 	*	last - Last byte in range.
 	*/
-	template<unsigned int N>
-	int Basic_word<N>::to_int(int first, int last) const
+	template<unsigned int N, typename M>
+	constexpr long long Basic_word<N, M>::to_int(int first, int last) const
 	{
 		int first_byte{first == 0 ? 1 : first};
 		check_range(first_byte, last);
-		int result{};
-		for (int i = first_byte; i <= last; ++i) {
-			result <<= BYTE_SIZE;
-			result += byte(i);
-		}
-		if (first == 0 && sign_byte == Sign::Minus) {
+		long long result{static_cast<long long>(lanes_to_value(
+			(bits & magnitude_range(first_byte, last)) >> byte_shift(last)
+		))};
+		if (first == 0 && sign() == Sign::Minus) {
 			result = -result;
 		}
 		return result;
@@ -613,21 +1254,29 @@ namespace mix
 	* Parameters:
 	*	fs - Field specification.
 	*/
-	template<unsigned int N>
-	int Basic_word<N>::to_int(const Field_spec& fs) const
+	template<unsigned int N, typename M>
+	constexpr long long Basic_word<N, M>::to_int(const Field_spec& fs) const
 	{
-		return to_int(fs.left, fs.right);
+		const Field_masks& m{field_masks(fs)};
+		long long result{static_cast<long long>(
+			lanes_to_value((bits & m.magnitude) >> m.magnitude_right)
+		)};
+		if ((bits & m.sign) == (Packed{1} << sign_bit)) {
+			result = -result;
+		}
+		return result;
 	}
 
 	/*
 	* Negate the sign of this basic word, returning a reference to it.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	Basic_word<N>& Basic_word<N>::negate()
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>& Basic_word<N, M>::negate()
 	{
-		negate_sign(sign_byte);
+		set_sign(sign() == Sign::Plus ? Sign::Minus : Sign::Plus);
 		return *this;
 	}
 
@@ -637,18 +1286,20 @@ namespace mix
 	* as possible without losing any byte in the field.
 	* Template parameters:
 	*	N - Number of bytes of the basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	field - Field to keep and left align.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::field_aligned_left(
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M> Basic_word<N, M>::field_aligned_left(
 			const Field_spec& field) const
 	{
-		Basic_word<N> copy{};
-		copy.copy_range(*this, field);
-		int shift_amount{(field.left == 0 ? 1 : field.left) - 1};
-		copy.shift_left(shift_amount);
-		return copy;
+		const Field_masks& m{field_masks(field)};
+		return from_packed(
+			((bits & m.magnitude) << m.magnitude_left)
+			| ((bits & m.flags) << m.flags_left)
+			| (bits & m.sign)
+		);
 	}
 
 	/*
@@ -657,20 +1308,20 @@ namespace mix
 	* as possible without losing any byte in the field.
 	* Template parameters:
 	*	N - Number of bytes of the basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	field - Field to keep and right align.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::field_aligned_right(
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M> Basic_word<N, M>::field_aligned_right(
 			const Field_spec& field) const
 	{
-		Basic_word<N> copy{};
-		if (field.right != 0) {
-			copy.copy_range(*this, field);
-			int shift_amount{static_cast<int>(N) - field.right};
-			copy.shift_right(shift_amount);
-		}
-		return copy;
+		const Field_masks& m{field_masks(field)};
+		return from_packed(
+			((bits & m.magnitude) >> m.magnitude_right)
+			| ((bits & m.flags) >> m.flags_right)
+			| (bits & m.aligned_sign)
+		);
 	}
 
 	/*
@@ -678,11 +1329,13 @@ namespace mix
 	* from this word taken from the left.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	amount - Number of left-most bytes desired.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::leftmost_bytes(int amount) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>
+	Basic_word<N, M>::leftmost_bytes(int amount) const
 	{
 		if (amount > N)
 			throw std::invalid_argument{"Requested too many bytes"};
@@ -696,14 +1349,16 @@ namespace mix
 	* from this word taken from the left, and the sign.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	amount - Number of left-most bytes desired.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::leftmost_with_sign(int amount) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>
+	Basic_word<N, M>::leftmost_with_sign(int amount) const
 	{
 		Basic_word copy{leftmost_bytes(amount)};
-		copy.sign_byte = sign_byte;
+		copy.set_sign(sign());
 		return copy;
 	}
 
@@ -712,11 +1367,13 @@ namespace mix
 	* taken from the right.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	amount - Number of right-most bytes desired.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::rightmost_bytes(int amount) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>
+	Basic_word<N, M>::rightmost_bytes(int amount) const
 	{
 		if (amount > N)
 			throw std::invalid_argument{"Requested too many bytes"};
@@ -730,14 +1387,16 @@ namespace mix
 	* taken from the right, and the sign.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	amount - Number of right-most bytes desired.
 	*/
-	template<unsigned int N>
-	Basic_word<N> Basic_word<N>::rightmost_with_sign(int amount) const
+	template<unsigned int N, typename M>
+	constexpr Basic_word<N, M>
+	Basic_word<N, M>::rightmost_with_sign(int amount) const
 	{
 		Basic_word copy{rightmost_bytes(amount)};
-		copy.sign_byte = sign_byte;
+		copy.set_sign(sign());
 		return copy;
 	}
 
@@ -748,12 +1407,13 @@ namespace mix
 	* Write the given basic word to the given output stream.
 	* Template parameters:
 	*	N - Number of bytes of the basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	os - Output stream to write to.
 	*	bw - Basic word to be written.
 	*/
-	template<unsigned int N>
-	std::ostream& operator<<(std::ostream& os, const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	std::ostream& operator<<(std::ostream& os, const Basic_word<N, M>& bw)
 	{
 		// Save current formatting then set to not skip whitespace.
 		std::ios_base::fmtflags f{os.flags()};
@@ -772,27 +1432,31 @@ namespace mix
 
 	/*
 	* Read a basic word from the given input stream.
+	* Any part of the word that could not be read is marked invalid.
 	* Template parameters:
 	*	N - number of bytes of the basic word.
+	*	M - Byte model.
 	* Parameters:
 	*	is - Input stream to read from.
 	*	bw - Basic word to read into.
 	*/
-	template<unsigned int N>
-	std::istream& operator>>(std::istream& is, Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	std::istream& operator>>(std::istream& is, Basic_word<N, M>& bw)
 	{
-		// Create an invalid basic word to mark any input problems.
-		Basic_word<N> temp{Sign::Invalid,
-						   std::vector<Byte>(N, INVALID_BYTE)};
+		Basic_word<N, M> temp{};
 
 		// Save current formatting then set to not skip whitespace.
 		std::ios_base::fmtflags f{is.flags()};
 		is >> std::noskipws;
 
 		// Read basic word.
-		is >> temp.sign();
+		Sign s{Sign::Invalid};
+		is >> s;
+		temp.sign() = (is ? s : Sign::Invalid);
 		for (int i = 1; i <= N; ++i) {
-			is >> temp.byte(i);
+			Byte b{INVALID_BYTE};
+			is >> b;
+			temp.byte(i) = (is ? b : INVALID_BYTE);
 		}
 
 		// Reset formatting.
@@ -806,28 +1470,42 @@ namespace mix
 	* Returns the maximum integer value this basic word can represent.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	int Basic_word<N>::int_max()
+	template<unsigned int N, typename M>
+	constexpr long long Basic_word<N, M>::int_max()
 	{
-		int max{};
-		for (int i = 0; i < num_bytes; ++i) {
-			max <<= BYTE_SIZE;
-			max += BYTE_MAX;
-		}
-		return max;
+		static_assert(modulus() - 1 <= static_cast<std::uint64_t>(
+						  std::numeric_limits<long long>::max()),
+					  "Every value of a basic word fits in a long long");
+		return static_cast<long long>(modulus() - 1);
 	}
 
 	/*
 	* Returns the minimum integer value this basic word can represent.
 	* Template parameters:
 	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
 	*/
-	template<unsigned int N>
-	int Basic_word<N>::int_min()
+	template<unsigned int N, typename M>
+	constexpr long long Basic_word<N, M>::int_min()
 	{
 		return -int_max();
 	}
+
+	/*
+	* Returns the number of distinct magnitudes of this basic word.
+	* Template parameters:
+	*	N - Number of bytes of this basic word.
+	*	M - Byte model.
+	*/
+	template<unsigned int N, typename M>
+	constexpr std::uint64_t Basic_word<N, M>::modulus()
+	{
+		std::uint64_t result{1};
+		for (unsigned int i = 0; i < N; ++i)
+			result *= M::radix;
+		return result;
+	}
 }
 #endif
-
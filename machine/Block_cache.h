@@ -0,0 +1,340 @@
+#ifndef MIX_MACHINE_BLOCK_CACHE_H
+#define MIX_MACHINE_BLOCK_CACHE_H
+
+#include "Byte.h"
+#include "Decode_cache.h"
+#include <memory>
+#include <vector>
+
+namespace mix
+{
+	// Most cells a translated block covers.
+	constexpr int MAX_BLOCK_LENGTH{64};
+
+	// A micro-op of a translated block: a predecoded instruction, or
+	// superinstruction, with the address of its first cell.
+	struct Micro_op
+	{
+		Predecoded entry;
+		int address;
+	};
+
+	// A translated block: the micro-ops of a straight-line run of cells.
+	struct Block
+	{
+		// Cells covered, [start, start + length).
+		int start;
+		int length;
+
+		// Micro-ops, in the cache's micro-op pool.
+		int first_op;
+		int num_ops;
+
+		// Block chained after this one, or no_block until it is resolved.
+		int next;
+
+		// Whether the block still matches memory.
+		bool valid;
+
+		// Times the block was entered while the JIT is on.
+		int entries;
+	};
+
+	// Block cache statistics.
+	struct Block_stats
+	{
+		// Blocks entered from the cache, by lookup or through a chain.
+		long long hits;
+
+		// Blocks entered through a chain link, without a lookup.
+		long long chained;
+
+		// Blocks translated, and the cells they covered.
+		long long translations;
+		long long translated_cells;
+
+		// Blocks invalidated by writes to their cells.
+		long long invalidations;
+
+		// Times the whole cache was dropped to make room.
+		long long flushes;
+
+		// Blocks compiled to native code.
+		long long compiled;
+
+		// Average number of cells of a translated block.
+		double average_length() const
+		{
+			return translations ?
+				static_cast<double>(translated_cells) / translations : 0;
+		}
+	};
+
+
+	// Translated blocks, at most one starting at each memory cell.
+	// Blocks are built by appending micro-ops, then closed. Writes to a
+	// cell must invalidate the blocks covering it. Blocks and micro-ops
+	// live in bounded pools; when one is full the whole cache is flushed.
+	// The pools grow by chunks as blocks are translated, so a cache costs
+	// memory in proportion to the code run, and chunks never move, so
+	// blocks and micro-ops keep their addresses while they are valid.
+	template<unsigned int Num_cells>
+	class Basic_block_cache
+	{
+	public:
+		// Index of no block.
+		static constexpr int no_block{-1};
+
+
+		// Constructor.
+		Basic_block_cache();
+
+
+		/* Operators. */
+
+		// Block access, unchecked.
+		const Block& operator[](int index) const
+		{
+			return pooled_block(index);
+		}
+
+
+		/* Functions. */
+
+		// Lookup, unchecked.
+		int find(int address) const { return block_at[address]; }
+		const Micro_op* ops(const Block& b) const
+		{
+			return &pooled_op(b.first_op);
+		}
+
+		// Translation.
+		int open(int);
+		void append(const Micro_op&);
+		int close(int, int);
+		void link(int, int);
+
+		// Entry counting, unchecked. Returns the new count.
+		int enter(int index) { return ++pooled_block(index).entries; }
+
+		// Invalidation.
+		void invalidate(int);
+		void invalidate_all();
+
+		// Times all blocks were dropped. Indices of blocks dropped in
+		// an earlier epoch may name new blocks.
+		long long epoch() const { return epochs; }
+
+		// Cover counts, by address, for native code.
+		const Byte* cover_counts() const { return covers; }
+
+		// Statistics.
+		Block_stats& stats() { return statistics; }
+		const Block_stats& stats() const { return statistics; }
+
+
+	private:
+		// Pool sizes. The micro-ops of a block never straddle two
+		// chunks, which wastes less than a block's worth per chunk.
+		static const int max_blocks{Num_cells};
+		static const int block_chunk_size{64};
+		static const int op_chunk_size{4 * MAX_BLOCK_LENGTH};
+		static const int max_ops{
+			Num_cells + MAX_BLOCK_LENGTH
+			+ (Num_cells / op_chunk_size + 1) * MAX_BLOCK_LENGTH
+		};
+
+		// Implementation.
+		std::vector<std::unique_ptr<Block[]>> block_chunks;
+		int num_blocks;
+		std::vector<std::unique_ptr<Micro_op[]>> op_chunks;
+		int num_ops;
+		int block_at[Num_cells];
+		Byte covers[Num_cells];
+		long long epochs;
+		Block_stats statistics;
+
+		// Pool access, unchecked.
+		Block& pooled_block(int index) const
+		{
+			const unsigned int i{static_cast<unsigned int>(index)};
+			return block_chunks[i / block_chunk_size][i % block_chunk_size];
+		}
+		Micro_op& pooled_op(int index) const
+		{
+			const unsigned int i{static_cast<unsigned int>(index)};
+			return op_chunks[i / op_chunk_size][i % op_chunk_size];
+		}
+
+		// Helper functions.
+		void invalidate_block(int);
+	};
+
+
+	/*
+	* Construct an empty block cache.
+	* Template parameters:
+	*	N - Number of memory cells.
+	*/
+	template<unsigned int N>
+	Basic_block_cache<N>::Basic_block_cache()
+		: block_chunks{}, num_blocks{0}, op_chunks{}, num_ops{0},
+		  block_at{}, covers{}, epochs{0}, statistics{}
+	{
+		for (int& b : block_at)
+			b = no_block;
+	}
+
+	/*
+	* Open a new block starting at the given address, and return its
+	* index. If the pools can't hold another block, the cache is flushed
+	* first, so the indices of all other blocks are no longer valid.
+	* Chunks are allocated when the block may reach past the last one.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	start - Address of the first cell of the block.
+	*/
+	template<unsigned int N>
+	int Basic_block_cache<N>::open(int start)
+	{
+		int first_op{num_ops};
+		if (op_chunk_size - first_op % op_chunk_size < MAX_BLOCK_LENGTH)
+			first_op += op_chunk_size - first_op % op_chunk_size;
+		if (num_blocks == max_blocks
+				|| max_ops - first_op < MAX_BLOCK_LENGTH) {
+			invalidate_all();
+			++statistics.flushes;
+			first_op = 0;
+		}
+		num_ops = first_op;
+		if (num_blocks == static_cast<int>(block_chunks.size())
+							* block_chunk_size) {
+			block_chunks.push_back(
+				std::make_unique<Block[]>(block_chunk_size));
+		}
+		if (static_cast<int>(op_chunks.size()) * op_chunk_size
+				< first_op + MAX_BLOCK_LENGTH) {
+			op_chunks.push_back(std::make_unique<Micro_op[]>(op_chunk_size));
+		}
+		Block& b{pooled_block(num_blocks)};
+		b = Block{start, 0, first_op, 0, no_block, true, 0};
+		return num_blocks++;
+	}
+
+	/*
+	* Append a micro-op to the block opened last.
+	* At most MAX_BLOCK_LENGTH micro-ops may be appended to a block.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	op - Micro-op to append.
+	*/
+	template<unsigned int N>
+	void Basic_block_cache<N>::append(const Micro_op& op)
+	{
+		pooled_op(num_ops++) = op;
+		++pooled_block(num_blocks - 1).num_ops;
+	}
+
+	/*
+	* Close the block opened last, covering the given number of cells,
+	* and return its index. An empty block is dropped, and no_block
+	* is returned instead.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	index - Index of the block.
+	*	length - Number of cells covered, at most MAX_BLOCK_LENGTH.
+	*/
+	template<unsigned int N>
+	int Basic_block_cache<N>::close(int index, int length)
+	{
+		Block& b{pooled_block(index)};
+		if (b.num_ops == 0) {
+			--num_blocks;
+			return no_block;
+		}
+		b.length = length;
+		block_at[b.start] = index;
+		for (int a = b.start; a < b.start + length; ++a)
+			++covers[a];
+		++statistics.translations;
+		statistics.translated_cells += length;
+		return index;
+	}
+
+	/*
+	* Chain one block to the block that follows it.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	from - Index of the block.
+	*	to - Index of the block starting where it ends.
+	*/
+	template<unsigned int N>
+	void Basic_block_cache<N>::link(int from, int to)
+	{
+		pooled_block(from).next = to;
+	}
+
+	/*
+	* Invalidate the blocks covering the given address.
+	* Cells outside all blocks take a single check.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*/
+	template<unsigned int N>
+	void Basic_block_cache<N>::invalidate(int address)
+	{
+		if (!covers[address])
+			return;
+		const int first{address < MAX_BLOCK_LENGTH ?
+						0 : address - MAX_BLOCK_LENGTH + 1};
+		for (int start = first; start <= address; ++start) {
+			const int b{block_at[start]};
+			if (b != no_block && address < start + pooled_block(b).length)
+				invalidate_block(b);
+		}
+	}
+
+	/*
+	* Drop all blocks, and start a new epoch.
+	* Template parameters:
+	*	N - Number of memory cells.
+	*/
+	template<unsigned int N>
+	void Basic_block_cache<N>::invalidate_all()
+	{
+		for (int i = 0; i < num_blocks; ++i)
+			pooled_block(i).valid = false;
+		num_blocks = 0;
+		num_ops = 0;
+		for (int& b : block_at)
+			b = no_block;
+		for (Byte& c : covers)
+			c = 0;
+		++epochs;
+	}
+
+	/*
+	* Invalidate the block with the given index.
+	* Template parameters:
+	*	N - Number of memory cells.
+	* Parameters:
+	*	index - Index of a valid block.
+	*/
+	template<unsigned int N>
+	void Basic_block_cache<N>::invalidate_block(int index)
+	{
+		Block& b{pooled_block(index)};
+		b.valid = false;
+		block_at[b.start] = no_block;
+		for (int a = b.start; a < b.start + b.length; ++a)
+			--covers[a];
+		++statistics.invalidations;
+	}
+}
+#endif
@@ -1,24 +1,45 @@
 #ifndef MIX_MACHINE_BYTE_H
 #define MIX_MACHINE_BYTE_H
 
-#include <cmath>
-
 namespace mix
 {
 	// A machine byte.
 	using Byte = unsigned char;
 
-	// Size of a machine byte.
-	const int BYTE_SIZE{6};
+	// Invalid byte indicator.
+	constexpr Byte INVALID_BYTE{static_cast<Byte>(-1)};
 
-	// Keeps BYTE_SIZE bits, clears unused bits.
-	const int BYTE_MASK{static_cast<int>(std::pow(2, BYTE_SIZE)) - 1};
 
-	// Maximum byte value.
-	const Byte BYTE_MAX{BYTE_MASK};
+	// A byte model: the number of values a byte holds, and the number
+	// of bits it takes in a packed word.
+	// Template parameters:
+	//	Size - Number of bits of a byte.
+	//	Radix - Number of values of a byte, at most 2 to the power of Size.
+	template<int Size, int Radix>
+	struct Byte_model
+	{
+		static_assert(Radix <= (1 << Size), "Byte radix does not fit in size");
 
-	// Invalid byte indicator.
-	const Byte INVALID_BYTE{static_cast<Byte>(-1)};
+		// Number of bits of a byte.
+		static constexpr int size{Size};
+
+		// Number of values of a byte.
+		static constexpr int radix{Radix};
+
+		// Keeps size bits, clears unused bits.
+		static constexpr int mask{(1 << Size) - 1};
+
+		// Maximum byte value.
+		static constexpr Byte max{Radix - 1};
+
+		// Whether every bit pattern of a byte is a value.
+		static constexpr bool binary{Radix == (1 << Size)};
+	};
+
+	// Binary mix, with 64 valued bytes.
+	using Binary_byte = Byte_model<6, 64>;
+
+	// Decimal mix, with 100 valued bytes.
+	using Decimal_byte = Byte_model<7, 100>;
 }
 #endif
-
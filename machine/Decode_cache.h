@@ -0,0 +1,275 @@
+#ifndef MIX_MACHINE_DECODE_CACHE_H
+#define MIX_MACHINE_DECODE_CACHE_H
+
+#include "Byte.h"
+#include "Decoder.h"
+#include "Instruction.h"
+#include "Memory.h"
+#include "Op_code.h"
+#include <cstdint>
+
+namespace mix
+{
+	class Machine;
+	struct Predecoded;
+
+	// Executes a decoded instruction on a machine.
+	using Handler = void (*)(Machine*, const Instruction&);
+
+	// Executes a predecoded instruction on a machine, with a handler
+	// specialized for it.
+	using Specialized_handler = void (*)(Machine*, const Predecoded&);
+
+	// Executes a superinstruction on a machine, given the predecoded
+	// instructions it fuses, in address order.
+	using Fused_handler = void (*)(Machine*, const Predecoded*);
+
+	// Most cells a superinstruction fuses.
+	constexpr int MAX_FUSED_LENGTH{3};
+
+	// Handler id of predecoded instructions without a handler.
+	constexpr Byte NO_HANDLER{0};
+
+	// A predecoded instruction, packed into 8 bytes, so the entries of
+	// the whole memory stay in cache alongside the data. Handlers are
+	// referred to by id, and the field by its encoding, which is also
+	// the index of its masks in the word field table.
+	struct Predecoded
+	{
+		// Address, before indexing.
+		std::int16_t address;
+
+		// Index register number.
+		Byte index_spec;
+
+		// Encoded field spec, which is also the modification.
+		Byte field;
+
+		// Op code.
+		Op_code op_code;
+
+		// Id of the handler specialized for the instruction,
+		// or NO_HANDLER. A specialized handler takes the entry.
+		Byte handler;
+
+		// Id of the superinstruction starting with the instruction,
+		// or NO_HANDLER. It takes the entries of all the cells it fuses.
+		Byte fused;
+
+		// Kind of dispatch of the run loop, in the low bits: Fused if
+		// there is a superinstruction, else Specialized if there is a
+		// handler, else the kind of operation. Number of cells the
+		// superinstruction fuses, in the high bits.
+		Byte flags;
+
+		// Layout of the flags.
+		static constexpr Byte kind_mask{0x0F};
+		static constexpr int length_shift{4};
+
+		/*
+		* Returns flags of the given kind and length.
+		* Parameters:
+		*	kind - Kind of dispatch.
+		*	length - Number of cells fused.
+		*/
+		static constexpr Byte make_flags(Op_kind kind, int length)
+		{
+			return static_cast<Byte>(kind | (length << length_shift));
+		}
+
+		// Kind of dispatch.
+		Op_kind kind() const
+		{
+			return static_cast<Op_kind>(flags & kind_mask);
+		}
+
+		// Number of cells the superinstruction fuses, or 1.
+		int length() const { return flags >> length_shift; }
+
+		/*
+		* Returns the instruction, with an unindexed address.
+		*/
+		Instruction instruction() const
+		{
+			return Instruction{
+				address,
+				index_spec,
+				Decoder::field_table[field].field,
+				field,
+				op_code
+			};
+		}
+	};
+
+	static_assert(sizeof(Predecoded) == 8,
+				  "Predecoded instructions are packed into 8 bytes");
+
+	/*
+	* Returns the entry of the given instruction, which no superinstruction
+	* starts.
+	* Parameters:
+	*	inst - Instruction, with an unindexed address and a valid field.
+	*	handler - Id of the specialized handler, or NO_HANDLER.
+	*	kind - Kind of dispatch.
+	*/
+	inline Predecoded make_predecoded(const Instruction& inst,
+									  Byte handler,
+									  Op_kind kind)
+	{
+		return Predecoded{
+			static_cast<std::int16_t>(inst.address),
+			static_cast<Byte>(inst.index_spec),
+			static_cast<Byte>(inst.field.encode()),
+			inst.op_code,
+			handler,
+			NO_HANDLER,
+			Predecoded::make_flags(kind, 1)
+		};
+	}
+
+	/*
+	* Returns the entry of the given decoded instruction, which no
+	* superinstruction starts. Its field is kept as encoded, even if
+	* it is invalid.
+	* Parameters:
+	*	decoded - Decoded instruction.
+	*	handler - Id of the specialized handler, or NO_HANDLER.
+	*	kind - Kind of dispatch.
+	*/
+	inline Predecoded make_predecoded(const Decoded_instruction& decoded,
+									  Byte handler,
+									  Op_kind kind)
+	{
+		return Predecoded{
+			decoded.address,
+			decoded.index_spec,
+			decoded.field,
+			decoded.op_code,
+			handler,
+			NO_HANDLER,
+			Predecoded::make_flags(kind, 1)
+		};
+	}
+
+
+	// Predecoded instructions, one entry per memory cell.
+	// An entry is filled the first time its cell is executed, and holds
+	// everything about the instruction that doesn't depend on machine
+	// state. The address is kept unindexed, since index registers change
+	// between executions. Writes to a cell must invalidate its entry, and
+	// the entries of superinstructions that may cover it.
+	template<unsigned int Num_cells>
+	class Basic_decode_cache
+	{
+	public:
+		// Number of entries.
+		static const unsigned int num_cells = Num_cells;
+
+
+		// Constructor.
+		Basic_decode_cache();
+
+
+		/* Operators. */
+
+		// Entry access, unchecked.
+		const Predecoded& operator[](int address) const
+		{
+			return entries[address];
+		}
+
+
+		/* Functions. */
+
+		// Entry state, unchecked.
+		bool is_decoded(int address) const { return decoded[address]; }
+
+		// Entry flags, by address, for native code.
+		const bool* decoded_flags() const { return decoded; }
+		void fill(int, const Predecoded&);
+		void fuse(int, Byte, int);
+		void invalidate(int);
+		void invalidate_all();
+
+
+	private:
+		// Implementation.
+		alignas(CACHE_LINE_SIZE) Predecoded entries[Num_cells];
+		bool decoded[Num_cells];
+	};
+
+
+	/*
+	* Construct a cache with no decoded entries.
+	* Template parameters:
+	*	N - Number of entries.
+	*/
+	template<unsigned int N>
+	Basic_decode_cache<N>::Basic_decode_cache()
+		: decoded{}
+	{
+	}
+
+	/*
+	* Fill the entry of the given address.
+	* Template parameters:
+	*	N - Number of entries.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	entry - Predecoded instruction.
+	*/
+	template<unsigned int N>
+	void Basic_decode_cache<N>::fill(int address, const Predecoded& entry)
+	{
+		entries[address] = entry;
+		decoded[address] = true;
+	}
+
+	/*
+	* Make the entry of the given address start a superinstruction.
+	* The entries of all cells it fuses must be filled.
+	* Template parameters:
+	*	N - Number of entries.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	fused - Id of the superinstruction.
+	*	length - Number of cells fused, at most MAX_FUSED_LENGTH.
+	*/
+	template<unsigned int N>
+	void Basic_decode_cache<N>::fuse(int address, Byte fused, int length)
+	{
+		Predecoded& entry{entries[address]};
+		entry.fused = fused;
+		entry.flags = Predecoded::make_flags(Op_kind::Fused, length);
+	}
+
+	/*
+	* Invalidate the entry of the given address, and the entries of
+	* preceding cells whose superinstructions may cover it.
+	* Template parameters:
+	*	N - Number of entries.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*/
+	template<unsigned int N>
+	void Basic_decode_cache<N>::invalidate(int address)
+	{
+		const int first{address < MAX_FUSED_LENGTH ?
+						0 : address - MAX_FUSED_LENGTH + 1};
+		for (int a = first; a <= address; ++a)
+			decoded[a] = false;
+	}
+
+	/*
+	* Invalidate all entries.
+	* Template parameters:
+	*	N - Number of entries.
+	*/
+	template<unsigned int N>
+	void Basic_decode_cache<N>::invalidate_all()
+	{
+		for (bool& d : decoded)
+			d = false;
+	}
+}
+#endif
@@ -0,0 +1,23 @@
+#include "Decoder.h"
+
+namespace mix
+{
+	namespace Decoder
+	{
+		/*
+		* Decode the words in [first, last) as instructions.
+		* Every word decodes, whatever its status, so whole images
+		* disassemble and predecode in one pass.
+		* Parameters:
+		*	first - First word.
+		*	last - One past the last word.
+		*	out - Decoded instructions, one per word.
+		*/
+		void decode(const Word* first, const Word* last,
+					Decoded_instruction* out)
+		{
+			for (; first != last; ++first)
+				*out++ = decode(*first);
+		}
+	}
+}
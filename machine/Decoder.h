@@ -0,0 +1,268 @@
+#ifndef MIX_MACHINE_DECODER_H
+#define MIX_MACHINE_DECODER_H
+
+#include "Byte.h"
+#include "Field_spec.h"
+#include "Instruction.h"
+#include "Op_code.h"
+#include "Word.h"
+#include <array>
+#include <cstdint>
+#include <type_traits>
+
+namespace mix
+{
+	// Validity of a decoded instruction. Each status has the bits of
+	// the statuses it takes precedence over, so the status of a word
+	// is the union of the statuses of its parts.
+	enum class Decode_status : Byte
+	{
+		// The word decodes, and its op code has an operation.
+		Valid = 0x0,
+
+		// The op code has no operation.
+		Unknown_op_code = 0x1,
+
+		// The field spec has its left part after its right part.
+		Invalid_field = 0x3,
+
+		// The word has an invalid sign or byte.
+		Invalid_word = 0x7
+	};
+
+	// An instruction decoded by table, with an unindexed address.
+	// Fields not covered by the status are decoded anyway, so an
+	// unknown op code still disassembles.
+	struct Decoded_instruction
+	{
+		// Address, before indexing.
+		std::int16_t address;
+
+		// Index register number.
+		Byte index_spec;
+
+		// Encoded field spec, which is also the modification.
+		Byte field;
+
+		// Op code, and the kind of its operation.
+		Op_code op_code;
+		Op_kind kind;
+
+		// Validity.
+		Decode_status status;
+	};
+
+	static_assert(std::is_trivially_copyable<Decoded_instruction>::value,
+				  "Decoded instructions are copied as bytes");
+	static_assert(sizeof(Decoded_instruction) <= 8,
+				  "Decoded instructions take at most 8 bytes");
+
+
+	// Table-driven instruction decoder.
+	// Field specs and op codes are looked up in precomputed tables with
+	// one entry per value a byte lane can hold, so decoding never
+	// branches on the instruction, throws or allocates, and bytes index
+	// the tables unchecked. The tables decode takes fill a few cache
+	// lines, so they stay cached next to the machine's own state in the
+	// decode path. Lanes past the last field spec or op code,
+	// which only decimal words have, decode as invalid fields and
+	// unknown op codes.
+	namespace Decoder
+	{
+		// Number of entries of each table.
+		constexpr int table_size{1 << Word::byte_model::size};
+
+		// Number of encoded field specs.
+		constexpr int num_fields{Field_spec::ENCODE_VALUE
+								 * Field_spec::ENCODE_VALUE};
+
+		// A field spec table entry.
+		struct Field_entry
+		{
+			// Field spec, (0:0) if invalid.
+			Field_spec field;
+
+			// Whether the encoding is a valid field spec.
+			bool valid;
+		};
+
+		/*
+		* Returns the field spec table.
+		*/
+		constexpr std::array<Field_entry, table_size> make_field_table()
+		{
+			std::array<Field_entry, table_size> table{};
+			for (int encoded = 0; encoded < num_fields; ++encoded) {
+				const int left{encoded / Field_spec::ENCODE_VALUE};
+				const int right{encoded % Field_spec::ENCODE_VALUE};
+				if (left <= right)
+					table[encoded] = Field_entry{Field_spec{left, right}, true};
+			}
+			return table;
+		}
+
+		// Field specs, by byte value.
+		constexpr std::array<Field_entry, table_size> field_table{
+			make_field_table()
+		};
+
+		/*
+		* Returns the field status table.
+		*/
+		constexpr std::array<Decode_status, table_size> make_field_statuses()
+		{
+			std::array<Decode_status, table_size> table{};
+			for (int encoded = 0; encoded < table_size; ++encoded) {
+				table[encoded] = field_table[encoded].valid ?
+					Decode_status::Valid : Decode_status::Invalid_field;
+			}
+			return table;
+		}
+
+		// Statuses of field specs, by byte value, packed for decoding.
+		constexpr std::array<Decode_status, table_size> field_statuses{
+			make_field_statuses()
+		};
+
+		// An op code table entry: the kind of operation of an op code,
+		// and the status of an instruction with that op code, if its
+		// word and field are valid.
+		struct Op_entry
+		{
+			Op_kind kind;
+			Decode_status status;
+		};
+
+		/*
+		* Returns the op code table.
+		*/
+		constexpr std::array<Op_entry, table_size> make_op_table()
+		{
+			std::array<Op_entry, table_size> table{};
+			for (int code = 0; code < table_size; ++code) {
+				const Op_kind kind{op_kind(static_cast<Op_code>(code))};
+				table[code] = Op_entry{
+					kind,
+					kind == Op_kind::Unknown ?
+						Decode_status::Unknown_op_code : Decode_status::Valid
+				};
+			}
+			return table;
+		}
+
+		// Operation kinds and statuses, by op code byte value.
+		constexpr std::array<Op_entry, table_size> op_table{make_op_table()};
+
+		// Layout of a packed word.
+		constexpr Word::Packed MINUS{Word{Sign::Minus}.packed()};
+		constexpr Word::Packed SIGN{Word::field_masks({0, 0}).sign};
+		constexpr Word::Packed INVALID{
+			Word{Sign::Invalid}.packed()
+				| Word::field_masks({1, Word::num_bytes}).flags
+		};
+
+		// Position of a byte in a packed word.
+		struct Lane
+		{
+			Word::Packed mask;
+			unsigned int shift;
+		};
+
+		/*
+		* Returns the lanes of the bytes of a packed word, by byte index.
+		*/
+		constexpr std::array<Lane, Word::num_bytes + 1> make_lanes()
+		{
+			std::array<Lane, Word::num_bytes + 1> lanes{};
+			for (int i = 1; i <= static_cast<int>(Word::num_bytes); ++i) {
+				const Word::Field_masks& masks{Word::field_masks({i, i})};
+				lanes[i] = Lane{masks.magnitude, masks.magnitude_right};
+			}
+			return lanes;
+		}
+
+		// Lanes of the bytes, by byte index.
+		constexpr std::array<Lane, Word::num_bytes + 1> lanes{make_lanes()};
+
+		/*
+		* Returns the byte of the given packed word at the given index.
+		* Parameters:
+		*	bits - Packed word.
+		*	i - Byte index, in range [1, 5].
+		*/
+		constexpr int byte(Word::Packed bits, int i)
+		{
+			return static_cast<int>((bits & lanes[i].mask) >> lanes[i].shift);
+		}
+
+		/*
+		* Decode the given word as an instruction, without offsetting
+		* its address by an index register.
+		* The bytes are read straight from the packed word.
+		* Parameters:
+		*	word - Word to decode.
+		*/
+		inline Decoded_instruction decode(const Word& word)
+		{
+			const Word::Packed bits{word.packed()};
+			const int magnitude{
+				byte(bits, 1) * Word::byte_model::radix + byte(bits, 2)
+			};
+			const int field{byte(bits, FIELD_SPEC)};
+			const Op_code code{static_cast<Op_code>(byte(bits, OP_CODE))};
+			const Op_entry entry{op_table[code]};
+
+			// An invalid word takes precedence over an invalid field,
+			// which takes precedence over an unknown op code.
+			const Byte invalid{static_cast<Byte>(
+				-static_cast<int>((bits & INVALID) != 0)
+					& static_cast<int>(Decode_status::Invalid_word)
+			)};
+			const Byte status{static_cast<Byte>(
+				invalid | static_cast<Byte>(field_statuses[field])
+					| static_cast<Byte>(entry.status)
+			)};
+			return Decoded_instruction{
+				static_cast<std::int16_t>(
+					(bits & SIGN) == MINUS ? -magnitude : magnitude),
+				static_cast<Byte>(byte(bits, INDEX_SPEC)),
+				static_cast<Byte>(field),
+				code,
+				entry.kind,
+				static_cast<Decode_status>(status)
+			};
+		}
+
+		/*
+		* Returns the field spec of the given decoded instruction,
+		* or (0:0) if its field is invalid.
+		* Parameters:
+		*	decoded - Decoded instruction.
+		*/
+		inline Field_spec field_spec(const Decoded_instruction& decoded)
+		{
+			return field_table[decoded.field].field;
+		}
+
+		/*
+		* Returns the given decoded instruction as an instruction,
+		* with an unindexed address.
+		* Parameters:
+		*	decoded - Decoded instruction, with a valid field.
+		*/
+		inline Instruction to_instruction(const Decoded_instruction& decoded)
+		{
+			return Instruction{
+				decoded.address,
+				decoded.index_spec,
+				field_spec(decoded),
+				decoded.field,
+				decoded.op_code
+			};
+		}
+
+		// Decoding whole images.
+		void decode(const Word*, const Word*, Decoded_instruction*);
+	}
+}
+#endif
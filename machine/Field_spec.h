@@ -1,6 +1,8 @@
 #ifndef MIX_MACHINE_FIELD_SPEC_H
 #define MIX_MACHINE_FIELD_SPEC_H
 
+#include <stdexcept>
+
 namespace mix
 {
 	
@@ -11,29 +13,115 @@ namespace mix
 		static const int ENCODE_VALUE{8};
 
 		// Constructor.
-		Field_spec(int, int);
+		constexpr Field_spec(int l = 0, int r = 0);
 
 		// Operators.
-		bool operator==(const Field_spec&) const;
-		bool operator!=(const Field_spec&) const;
+		constexpr bool operator==(const Field_spec&) const;
+		constexpr bool operator!=(const Field_spec&) const;
 
 		// Properties.
 		int left;
 		int right;
 
 		// Functions.
-		int bytes() const;
-		int size() const;
-		int encode() const;
-		bool contains_sign() const;
+		constexpr int bytes() const;
+		constexpr int size() const;
+		constexpr int encode() const;
+		constexpr bool contains_sign() const;
 
 	private:
 		// Check if field spec is valid.
-		bool valid() const;
+		constexpr bool valid() const;
 	};
 
 	// Decode an encoded field spec.
-	Field_spec decode_field_spec(int);
+	constexpr Field_spec decode_field_spec(int);
+
+
+	/*
+	* Construct a field specification.
+	*/
+	constexpr Field_spec::Field_spec(int l, int r)
+		: left{l}, right{r}
+	{
+		if (!valid())
+			throw std::invalid_argument{"Invalid field specification"};
+	}
+
+	/*
+	* Checks if the field spec is valid.
+	*/
+	constexpr bool Field_spec::valid() const
+	{
+		bool is_valid{true};
+		if (left < 0) is_valid = false;
+		if (left > right) is_valid = false;
+		return is_valid;
+	}
+
+	/*
+	* Determines whether or not the given field spec is equal to this one.
+	*/
+	constexpr bool Field_spec::operator==(const Field_spec& fs) const
+	{
+		return left == fs.left && right == fs.right;
+	}
+
+	/*
+	* Determines whether or not the given field spec is different to this one.
+	*/
+	constexpr bool Field_spec::operator!=(const Field_spec& fs) const
+	{
+		return !(*this == fs);
+	}
+
+	/*
+	* Return the number of bytes included in the field specification.
+	* Excludes the sign.
+	*/
+	constexpr int Field_spec::bytes() const
+	{
+		int bytes{size()};
+		if (left == 0) --bytes;
+		return bytes;
+	}
+
+	/*
+	* Returns the number of bytes in the range specified by this field spec.
+	*/
+	constexpr int Field_spec::size() const
+	{
+		return right - left + 1;
+	}
+
+	/*
+	* Encode the field specification.
+	*/
+	constexpr int Field_spec::encode() const
+	{
+		int encoded = right;
+		encoded += (left * ENCODE_VALUE);
+		return encoded;
+	}
+
+	/*
+	* Returns whether or not the sign is part of the specified field.
+	*/
+	constexpr bool Field_spec::contains_sign() const
+	{
+		return left == 0;
+	}
+
+	/*
+	* Decode an encoded field specification.
+	* Parameters:
+	*	encoded - Encoded field spec.
+	*/
+	constexpr Field_spec decode_field_spec(int encoded)
+	{
+		int left{encoded / Field_spec::ENCODE_VALUE};
+		int right{encoded % Field_spec::ENCODE_VALUE};
+		return Field_spec{left, right};
+	}
 }
 #endif
-
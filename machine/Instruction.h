@@ -9,40 +9,40 @@
 namespace mix
 {
 	// Constants for the parts of an instruction.
-	const Field_spec ADDRESS_FIELD{0, 2};
-	const unsigned int INDEX_SPEC{3};
-	const unsigned int FIELD_SPEC{4};
-	const unsigned int MODIFICATION{4};
-	const unsigned int OP_CODE{5};
+	constexpr Field_spec ADDRESS_FIELD{0, 2};
+	constexpr unsigned int INDEX_SPEC{3};
+	constexpr unsigned int FIELD_SPEC{4};
+	constexpr unsigned int MODIFICATION{4};
+	constexpr unsigned int OP_CODE{5};
 
 	// Functions for accessing named parts of a word.
-	template<unsigned int N>
-	int get_address(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr int get_address(const Basic_word<N, M>& bw)
 	{
 		return bw.to_int(ADDRESS_FIELD);
 	}
 
-	template<unsigned int N>
-	Byte get_index_spec(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr Byte get_index_spec(const Basic_word<N, M>& bw)
 	{
 		return bw.byte(INDEX_SPEC);
 	}
 
-	template<unsigned int N>
-	Field_spec get_field_spec(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr Field_spec get_field_spec(const Basic_word<N, M>& bw)
 	{
 		Byte encoded_field{bw.byte(FIELD_SPEC)};
 		return decode_field_spec(encoded_field);
 	}
 
-	template<unsigned int N>
-	Op_code get_op_code(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr Op_code get_op_code(const Basic_word<N, M>& bw)
 	{
 		return static_cast<Op_code>(bw.byte(OP_CODE));
 	}
 
-	template<unsigned int N>
-	int get_modification(const Basic_word<N>& bw)
+	template<unsigned int N, typename M>
+	constexpr int get_modification(const Basic_word<N, M>& bw)
 	{
 		return bw.byte(MODIFICATION);
 	}
@@ -56,6 +56,63 @@ namespace mix
 		int modification;
 		Op_code op_code;
 	};
+
+	/*
+	* Decode the given word as an instruction, without offsetting the
+	* address by an index register. Everything decoded here depends only
+	* on the word, so the result can be cached per memory cell.
+	* Parameters:
+	*	word - Word to decode.
+	*/
+	constexpr Instruction decode_unindexed(const Word& word)
+	{
+		return Instruction{
+			get_address(word),
+			get_index_spec(word),
+			get_field_spec(word),
+			get_modification(word),
+			get_op_code(word)
+		};
+	}
+
+	/*
+	* Returns whether the given word decodes as an instruction,
+	* that is, whether decode_unindexed accepts its field spec.
+	* Parameters:
+	*	word - Word to check.
+	*/
+	constexpr bool is_decodable(const Word& word)
+	{
+		const int encoded{word.byte(FIELD_SPEC)};
+		return encoded / Field_spec::ENCODE_VALUE
+			<= encoded % Field_spec::ENCODE_VALUE;
+	}
+
+	/*
+	* Encode the given instruction as a word.
+	* This is the inverse of Machine::decode for instructions whose
+	* address is not offset by an index register: the address is
+	* written as given. The field spec is written as byte 4, so the
+	* modification is ignored.
+	* Parameters:
+	*	inst - Instruction to encode.
+	*/
+	constexpr Word encode(const Instruction& inst)
+	{
+		const int magnitude{inst.address < 0 ? -inst.address : inst.address};
+		if (magnitude > Half_word::int_max())
+			throw std::invalid_argument{"Instruction address too big"};
+		return Word{
+			inst.address < 0 ? Sign::Minus : Sign::Plus,
+			{
+				static_cast<Byte>(magnitude / Word::byte_model::radix),
+				static_cast<Byte>(magnitude % Word::byte_model::radix),
+				static_cast<Byte>(inst.index_spec),
+				static_cast<Byte>(inst.field.encode()),
+				inst.op_code
+			}
+		};
+	}
 }
 #endif
 
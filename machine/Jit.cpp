@@ -0,0 +1,805 @@
+#include "Jit.h"
+#include "Machine.h"
+#include "Op_specializations.h"
+#include "Op_table.h"
+#include "Operations.h"
+#include "Superinstructions.h"
+#include "X86_emitter.h"
+#include <cstddef>
+#include <cstdint>
+
+#ifdef MIX_JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+namespace mix
+{
+	namespace
+	{
+		// Calls the operation of a predecoded instruction. Returns whether
+		// the block goes on: false if the operation threw, finished the
+		// program or wrote over the block.
+		using Thunk = bool (*)(Machine*, const Predecoded*,
+							   const Native_frame*);
+
+		// Exception thrown by the last operation called from native code.
+		thread_local std::exception_ptr pending;
+
+		/*
+		* Returns whether a block goes on after an operation
+		* that didn't throw.
+		* Parameters:
+		*	frame - Frame of the block.
+		*/
+		bool goes_on(const Native_frame* frame)
+		{
+			return !*frame->finished && *frame->valid;
+		}
+
+		/*
+		* Execute the given instruction, with its address offset by its
+		* index register, as the given operation.
+		* Template parameters:
+		*	Operation - Operation of the instruction.
+		* Parameters:
+		*	mix_machine - Mix machine used to execute the instruction.
+		*	entry - Predecoded instruction.
+		*	frame - Frame of the block.
+		*/
+		template<typename Operation>
+		bool execute_generic(Machine* mix_machine,
+							 const Predecoded* entry,
+							 const Native_frame* frame)
+		{
+			try {
+				Instruction inst{entry->instruction()};
+				if (inst.index_spec != 0) {
+					const Half_word offset{
+						mix_machine->fetch_index(inst.index_spec)
+					};
+					inst.address += get_address(offset);
+				}
+				Operation{}.execute(mix_machine, inst);
+			}
+			catch (...) {
+				pending = std::current_exception();
+				return false;
+			}
+			return goes_on(frame);
+		}
+
+		// Operation of instructions whose op code has none.
+		struct Unknown_operation
+		{
+			void execute(Machine* mix_machine, const Instruction& inst)
+			{
+				Op_table::execute_unknown(mix_machine, inst);
+			}
+		};
+
+		/*
+		* Execute the given instruction with its specialized handler.
+		* Parameters:
+		*	mix_machine - Mix machine used to execute the instruction.
+		*	entry - Predecoded instruction.
+		*	frame - Frame of the block.
+		*/
+		bool execute_specialized(Machine* mix_machine,
+								 const Predecoded* entry,
+								 const Native_frame* frame)
+		{
+			try {
+				Op_specializations::handler(entry->handler)(mix_machine,
+															*entry);
+			}
+			catch (...) {
+				pending = std::current_exception();
+				return false;
+			}
+			return goes_on(frame);
+		}
+
+		/*
+		* Execute the superinstruction starting with the given instruction.
+		* Parameters:
+		*	mix_machine - Mix machine used to execute the instructions.
+		*	entry - Predecoded instruction of the first cell fused, in the
+		*		decode cache, followed by the others.
+		*	frame - Frame of the block.
+		*/
+		bool execute_fused(Machine* mix_machine,
+						   const Predecoded* entry,
+						   const Native_frame* frame)
+		{
+			try {
+				Superinstructions::handler(entry->fused)(mix_machine, entry);
+			}
+			catch (...) {
+				pending = std::current_exception();
+				return false;
+			}
+			return goes_on(frame);
+		}
+
+		// Thunks, indexed by dispatch kind.
+		const Thunk thunks[]{
+			execute_generic<Unknown_operation>,
+			execute_generic<Math_operation>,
+			execute_generic<Shift_operation>,
+			execute_generic<Load_operation>,
+			execute_generic<Load_neg_operation>,
+			execute_generic<Store_operation>,
+			execute_specialized,
+			execute_fused
+		};
+
+		/*
+		* Returns the given pointer as an immediate operand.
+		* Parameters:
+		*	p - Pointer to data.
+		*/
+		std::uint64_t immediate(const void* p)
+		{
+			return reinterpret_cast<std::uintptr_t>(p);
+		}
+
+
+		/*** Inline operations. ***/
+
+		using R = X86_emitter;
+		using Packed = Word::Packed;
+
+		// Only binary words add, and index addresses, with plain integer
+		// arithmetic on their bytes.
+		constexpr bool INLINE_ARITHMETIC{Word::byte_model::binary};
+
+		static_assert(sizeof(Word) == sizeof(Packed)
+					  && sizeof(Half_word) == sizeof(Packed),
+					  "Inline operations access packed words in place");
+		static_assert(Word{}.packed() == 0, "+0 packs to zero");
+
+		// Masks of the packed representation of a word.
+		constexpr Word::Field_masks whole_word{
+			Word::field_masks(Field_spec{0, Word::num_bytes})
+		};
+		constexpr Packed word_minus{Word{Sign::Minus}.packed()};
+		constexpr Packed word_invalid{
+			whole_word.field & ~(whole_word.magnitude | word_minus)
+		};
+
+		// Masks of the packed representation of an index register.
+		constexpr Half_word::Field_masks whole_half_word{
+			Half_word::field_masks(ADDRESS_FIELD)
+		};
+		constexpr Packed half_word_minus{Half_word{Sign::Minus}.packed()};
+		constexpr Packed half_word_invalid{
+			whole_half_word.field
+				& ~(whole_half_word.magnitude | half_word_minus)
+		};
+
+		// Decode cache flags a store checks, from MAX_FUSED_LENGTH - 1
+		// cells before its own: the cells whose entries it invalidates.
+		constexpr int CHECKED_FLAGS{4};
+		static_assert(MAX_FUSED_LENGTH <= CHECKED_FLAGS,
+					  "Stores check the flags of all cells they invalidate");
+
+		// A memory operand of an inline operation: registers and
+		// displacements of its cell, and of the decode cache flags and
+		// block cache cover count a store to it checks.
+		struct Cell_operand
+		{
+			R::Reg base;
+			std::int32_t cell;
+			R::Reg flags_base;
+			std::int32_t decoded;
+			std::int32_t covers;
+		};
+
+		/*
+		* Returns the kind of thunk running the given instruction alone,
+		* even if it starts a superinstruction.
+		* Parameters:
+		*	entry - Predecoded instruction.
+		*/
+		Op_kind thunk_kind(const Predecoded& entry)
+		{
+			return entry.handler != NO_HANDLER ? Op_kind::Specialized
+											   : op_kind(entry.op_code);
+		}
+
+		/*
+		* Returns whether the given instruction runs inline: a load or
+		* store of rA or rX, or an addition or subtraction, of a valid
+		* field, in a word that decodes. Unindexed instructions must
+		* address memory, and indexed ones must name an index register.
+		* Parameters:
+		*	layout - Machine state layout.
+		*	entry - Predecoded instruction.
+		*/
+		bool runs_inline(const Native_layout& layout, const Predecoded& entry)
+		{
+			if (layout.cells < 0
+					|| entry.handler == Op_specializations::INVALID_HANDLER)
+				return false;
+			switch (entry.op_code)
+			{
+			case Op_code::LDA:
+			case Op_code::LDX:
+			case Op_code::STA:
+			case Op_code::STX:
+			case Op_code::STZ:
+				break;
+			case Op_code::ADD:
+			case Op_code::SUB:
+				if (!INLINE_ARITHMETIC)
+					return false;
+				break;
+			default:
+				return false;
+			}
+			const Decoder::Field_entry& field{
+				Decoder::field_table[entry.field]
+			};
+			if (!field.valid || field.field.right > Word::num_bytes)
+				return false;
+			if (entry.index_spec != 0) {
+				return INLINE_ARITHMETIC
+					&& entry.index_spec <= Machine::num_index_registers;
+			}
+			const int size{static_cast<int>(Machine::mem_size)};
+			return 0 <= entry.address && entry.address < size;
+		}
+
+		/*
+		* Emit the address of the cell of the given instruction, and
+		* return where to find it. Indexed addresses take rsi and rdi,
+		* and jump to the slow path if the index register holds an
+		* invalid word, or the address falls outside memory.
+		* Parameters:
+		*	e - Emitter.
+		*	layout - Machine state layout.
+		*	entry - Predecoded instruction that runs inline.
+		*	slow - Jumps to the slow path.
+		*/
+		Cell_operand emit_cell(X86_emitter& e,
+							   const Native_layout& layout,
+							   const Predecoded& entry,
+							   std::vector<int>& slow)
+		{
+			constexpr int word_size{sizeof(Packed)};
+			constexpr int before{MAX_FUSED_LENGTH - 1};
+			if (entry.index_spec == 0) {
+				// Constant addresses check flags inside the cache only.
+				const int last{
+					static_cast<int>(Machine::mem_size) - CHECKED_FLAGS
+				};
+				const int first{entry.address < before ?
+								0 : entry.address - before};
+				return Cell_operand{
+					R::r12, layout.cells + entry.address * word_size,
+					R::r12, layout.decoded + (first < last ? first : last),
+					layout.covers + entry.address
+				};
+			}
+			const int index{layout.index + (entry.index_spec - 1) * word_size};
+			e.load(R::rcx, R::r12, index);
+			e.mov(R::r8, half_word_invalid);
+			e.test(R::rcx, R::r8);
+			slow.push_back(e.jump(R::not_zero));
+
+			// rsi = address + signed index, in [0, mem_size).
+			e.mov32(R::r8,
+					static_cast<std::uint32_t>(whole_half_word.magnitude));
+			e.mov(R::rsi, R::rcx);
+			e.alu(R::bit_and, R::rsi, R::r8);
+			e.mov(R::rdi, R::rsi);
+			e.neg(R::rdi);
+			e.mov32(R::r8, static_cast<std::uint32_t>(half_word_minus));
+			e.test(R::rcx, R::r8);
+			e.cmov(R::not_zero, R::rsi, R::rdi);
+			e.lea(R::rsi, R::rsi, entry.address);
+			e.mov32(R::r8, Machine::mem_size);
+			e.alu(R::cmp, R::rsi, R::r8);
+			slow.push_back(e.jump(R::above_equal));
+
+			// rdi addresses bytes by cell, and rsi words.
+			e.mov(R::rdi, R::rsi);
+			e.alu(R::add, R::rdi, R::r12);
+			e.shift(R::shl, R::rsi, 3);
+			e.alu(R::add, R::rsi, R::r12);
+			// Flags checked past either end of the cache belong to the
+			// machine, and only send the store down the slow path.
+			return Cell_operand{
+				R::rsi, layout.cells,
+				R::rdi, layout.decoded - before, layout.covers
+			};
+		}
+
+		/*
+		* Emit rdx = rax & mask, shifted right, or'ed into rdx unless it
+		* is the first part. Takes rcx and r8.
+		* Parameters:
+		*	e - Emitter.
+		*	mask - Bits to keep.
+		*	shift - Number of bits to shift right by.
+		*	first - Whether this is the first part of rdx.
+		*/
+		void emit_part(X86_emitter& e, Packed mask, int shift, bool first)
+		{
+			const R::Reg part{first ? R::rdx : R::rcx};
+			e.mov(part, R::rax);
+			e.mov(R::r8, mask);
+			e.alu(R::bit_and, part, R::r8);
+			if (shift != 0)
+				e.shift(R::shr, part, static_cast<Byte>(shift));
+			if (!first)
+				e.alu(R::bit_or, R::rdx, R::rcx);
+		}
+
+		/*
+		* Emit rdx = the given field of rax, aligned right, as by
+		* Basic_word::field_aligned_right. Takes rcx and r8.
+		* Parameters:
+		*	e - Emitter.
+		*	m - Masks of the field.
+		*/
+		void emit_aligned_right(X86_emitter& e, const Word::Field_masks& m)
+		{
+			if (m.field == whole_word.field) {
+				e.mov(R::rdx, R::rax);
+				return;
+			}
+			if (m.magnitude_right == m.flags_right) {
+				emit_part(e, m.magnitude | m.flags, m.magnitude_right, true);
+			}
+			else {
+				emit_part(e, m.magnitude, m.magnitude_right, true);
+				emit_part(e, m.flags, m.flags_right, false);
+			}
+			if (m.aligned_sign != 0)
+				emit_part(e, m.aligned_sign, 0, false);
+		}
+
+		/*
+		* Emit the insertion of the right-most bytes of rax into the given
+		* field of the given cell, as by Basic_word::insert_field. Takes
+		* rcx, rdx and r8.
+		* Parameters:
+		*	e - Emitter.
+		*	cell - Cell to write.
+		*	m - Masks of the field.
+		*/
+		void emit_insert(X86_emitter& e,
+						 const Cell_operand& cell,
+						 const Word::Field_masks& m)
+		{
+			if (m.field == whole_word.field) {
+				e.store(cell.base, cell.cell, R::rax);
+				return;
+			}
+			e.load(R::rdx, cell.base, cell.cell);
+			e.mov(R::r8, ~m.field);
+			e.alu(R::bit_and, R::rdx, R::r8);
+
+			// Bits above the magnitude stay above it when shifted left.
+			e.mov(R::rcx, R::rax);
+			if (m.magnitude_right != 0)
+				e.shift(R::shl, R::rcx, m.magnitude_right);
+			e.mov(R::r8, m.magnitude);
+			e.alu(R::bit_and, R::rcx, R::r8);
+			e.alu(R::bit_or, R::rdx, R::rcx);
+
+			e.mov(R::rcx, R::rax);
+			e.mov(R::r8, whole_word.flags);
+			e.alu(R::bit_and, R::rcx, R::r8);
+			if (m.flags_right != 0)
+				e.shift(R::shl, R::rcx, m.flags_right);
+			e.mov(R::r8, m.flags);
+			e.alu(R::bit_and, R::rcx, R::r8);
+			e.alu(R::bit_or, R::rdx, R::rcx);
+
+			if (m.sign != 0) {
+				e.mov(R::rcx, R::rax);
+				e.mov(R::r8, m.sign);
+				e.alu(R::bit_and, R::rcx, R::r8);
+				e.alu(R::bit_or, R::rdx, R::rcx);
+			}
+			e.store(cell.base, cell.cell, R::rdx);
+		}
+
+		/*
+		* Emit dst = the signed value of the valid binary word in src.
+		* Takes rcx. r8 must hold the magnitude mask, and r9 the sign bit.
+		* Parameters:
+		*	e - Emitter.
+		*	dst - Destination register.
+		*	src - Register holding the word.
+		*/
+		void emit_signed(X86_emitter& e, R::Reg dst, R::Reg src)
+		{
+			e.mov(dst, src);
+			e.alu(R::bit_and, dst, R::r8);
+			e.mov(R::rcx, dst);
+			e.neg(R::rcx);
+			e.test(src, R::r9);
+			e.cmov(R::not_zero, dst, R::rcx);
+		}
+
+		/*
+		* Emit rA = rA + rdx, or rA - rdx, with the overflow and sign
+		* rules of add() on binary words. Invalid words take the slow
+		* path. Takes rax, rcx, rsi, rdi, r8 and r9.
+		* Parameters:
+		*	e - Emitter.
+		*	layout - Machine state layout.
+		*	code - ADD or SUB.
+		*	slow - Jumps to the slow path.
+		*/
+		void emit_add(X86_emitter& e,
+					  const Native_layout& layout,
+					  Op_code code,
+					  std::vector<int>& slow)
+		{
+			e.load(R::rax, R::r12, layout.accumulator);
+			e.mov(R::rcx, R::rax);
+			e.alu(R::bit_or, R::rcx, R::rdx);
+			e.mov(R::r8, word_invalid);
+			e.test(R::rcx, R::r8);
+			slow.push_back(e.jump(R::not_zero));
+
+			e.mov32(R::r8, static_cast<std::uint32_t>(whole_word.magnitude));
+			e.mov32(R::r9, static_cast<std::uint32_t>(word_minus));
+			if (code == Op_code::SUB)
+				e.alu(R::bit_xor, R::rdx, R::r9);
+			emit_signed(e, R::rsi, R::rax);
+			emit_signed(e, R::rdi, R::rdx);
+			e.alu(R::add, R::rsi, R::rdi);
+
+			// rcx = |sum|, modulo the word size, setting overflow.
+			e.mov(R::rcx, R::rsi);
+			e.neg(R::rcx);
+			e.cmov(R::sign, R::rcx, R::rsi);
+			e.alu(R::cmp, R::rcx, R::r8);
+			const int fits{e.jump(R::below_equal)};
+			e.store8(R::r12, layout.overflow,
+					 static_cast<Byte>(Machine::Bit::On));
+			e.bind(fits, e.size());
+			e.alu(R::bit_and, R::rcx, R::r8);
+
+			// A zero sum keeps the sign of rA.
+			e.alu(R::bit_and, R::rax, R::r9);
+			e.mov32(R::rdi, 0);
+			e.test(R::rsi, R::rsi);
+			e.cmov(R::sign, R::rdi, R::r9);
+			e.cmov(R::zero, R::rdi, R::rax);
+			e.alu(R::bit_or, R::rcx, R::rdi);
+			e.store(R::r12, layout.accumulator, R::rcx);
+		}
+
+		/*
+		* Emit the fast path of an instruction that runs inline.
+		* Parameters:
+		*	e - Emitter.
+		*	layout - Machine state layout.
+		*	entry - Predecoded instruction that runs inline.
+		*	slow - Jumps to the slow path.
+		*/
+		void emit_inline(X86_emitter& e,
+						 const Native_layout& layout,
+						 const Predecoded& entry,
+						 std::vector<int>& slow)
+		{
+			const Word::Field_masks& m{
+				Word::field_masks(Decoder::field_table[entry.field].field)
+			};
+			const Cell_operand cell{emit_cell(e, layout, entry, slow)};
+			switch (entry.op_code)
+			{
+			case Op_code::LDA:
+			case Op_code::LDX:
+				e.load(R::rax, cell.base, cell.cell);
+				emit_aligned_right(e, m);
+				e.store(R::r12, entry.op_code == Op_code::LDA ?
+						layout.accumulator : layout.extension, R::rdx);
+				break;
+			case Op_code::ADD:
+			case Op_code::SUB:
+				e.load(R::rax, cell.base, cell.cell);
+				emit_aligned_right(e, m);
+				emit_add(e, layout, entry.op_code, slow);
+				break;
+			default:
+				// Cells holding decoded or translated code are written by
+				// the slow path, which invalidates them.
+				static_assert(CHECKED_FLAGS == sizeof(std::uint32_t),
+							  "Decode cache flags are checked as a dword");
+				e.cmp32(cell.flags_base, cell.decoded, 0);
+				slow.push_back(e.jump(R::not_zero));
+				e.cmp8(cell.flags_base, cell.covers, 0);
+				slow.push_back(e.jump(R::not_zero));
+				if (entry.op_code == Op_code::STZ)
+					e.mov32(R::rax, 0);
+				else
+					e.load(R::rax, R::r12, entry.op_code == Op_code::STA ?
+						   layout.accumulator : layout.extension);
+				emit_insert(e, cell, m);
+				break;
+			}
+		}
+	}
+
+	/*
+	* Construct a JIT for a machine.
+	* If the executable region can't be mapped, nothing is compiled.
+	* Parameters:
+	*	program_finished - End of program flag of the machine.
+	*	max_blocks - Number of blocks the block cache holds.
+	*	state - Layout of the machine's state.
+	*/
+	Jit::Jit(const bool* program_finished,
+			 int max_blocks,
+			 const Native_layout& state)
+		: code{nullptr},
+		  used{0},
+		  compiled(max_blocks, nullptr),
+		  frames(max_blocks),
+		  epoch{0},
+		  finished{program_finished},
+		  layout{state}
+	{
+#ifdef MIX_JIT_SUPPORTED
+		// Ask for the region near the thunks, so native code can call
+		// them directly. Elsewhere it calls them through the table.
+		const std::uintptr_t near_thunks{
+			(reinterpret_cast<std::uintptr_t>(thunks) + (1u << 30))
+				& ~std::uintptr_t{0xFFFF}
+		};
+		void* region{mmap(reinterpret_cast<void*>(near_thunks), code_size,
+						  PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+						  -1, 0)};
+		if (region != MAP_FAILED) {
+			code = static_cast<Byte*>(region);
+		}
+#endif
+	}
+
+	/*
+	* Destroy the JIT, and unmap its executable region.
+	*/
+	Jit::~Jit()
+	{
+#ifdef MIX_JIT_SUPPORTED
+		if (code) {
+			munmap(code, code_size);
+		}
+#endif
+	}
+
+	/*
+	* Returns the native code of the block with the given index,
+	* or null if it isn't compiled.
+	* Parameters:
+	*	index - Index of the block.
+	*	cache_epoch - Epoch of the block cache.
+	*/
+	Native_block Jit::find(int index, long long cache_epoch) const
+	{
+		return cache_epoch == epoch ? compiled[index] : nullptr;
+	}
+
+	/*
+	* Compile the given block, and return its native code,
+	* or null if it can't be compiled.
+	* Parameters:
+	*	index - Index of the block.
+	*	cache_epoch - Epoch of the block cache.
+	*	block - Valid block to compile.
+	*	ops - Micro-ops of the block.
+	*	entries - Predecoded instructions of the machine, from address 0.
+	*/
+	Native_block Jit::compile(int index,
+							  long long cache_epoch,
+							  const Block& block,
+							  const Micro_op* ops,
+							  const Predecoded* entries)
+	{
+#ifdef MIX_JIT_SUPPORTED
+		if (!code) {
+			return nullptr;
+		}
+		if (cache_epoch != epoch) {
+			reset(cache_epoch);
+		}
+		Native_frame& frame{frames[index]};
+		frame = Native_frame{finished, &block.valid};
+		mprotect(code, code_size, PROT_READ | PROT_WRITE);
+		Native_block native{emit(block, ops, frame, entries)};
+		if (!native) {
+			// The region is full: start over.
+			reset(epoch);
+			native = emit(block, ops, frame, entries);
+		}
+		mprotect(code, code_size, PROT_READ | PROT_EXEC);
+		compiled[index] = native;
+		return native;
+#else
+		return nullptr;
+#endif
+	}
+
+	/*
+	* Run the given native code on the given machine, and return the
+	* address to resume at. An exception thrown by an operation is held
+	* until taken back.
+	* Parameters:
+	*	native - Native code of a valid block.
+	*	mix_machine - Mix machine to run.
+	*/
+	int Jit::run(Native_block native, Machine* mix_machine)
+	{
+		return native(mix_machine);
+	}
+
+	/*
+	* Returns the exception thrown by the last native run, if any,
+	* and clears it.
+	*/
+	std::exception_ptr Jit::take_exception()
+	{
+		std::exception_ptr e{pending};
+		pending = nullptr;
+		return e;
+	}
+
+	/*
+	* Emit the native code of the given block at the end of the region,
+	* and return it, or null if the region is full.
+	* The code follows the System V calling convention: it takes the
+	* machine in rdi, and keeps it, the micro-ops, the frame and the
+	* thunk table in callee-saved registers across calls, so each call
+	* only takes a few short instructions. Inline operations address
+	* machine state from the machine register. Their slow paths, and the
+	* exits, follow the epilogue, so the fast path runs straight through.
+	* Parameters:
+	*	block - Valid block to compile.
+	*	ops - Micro-ops of the block.
+	*	frame - Frame of the block.
+	*	entries - Predecoded instructions of the machine, from address 0.
+	*/
+	Native_block Jit::emit(const Block& block,
+						   const Micro_op* ops,
+						   const Native_frame& frame,
+						   const Predecoded* entries)
+	{
+		used = (used + 15) & ~15;
+		X86_emitter e{code + used, code_size - used};
+
+		// A stop after an operation, and the address to resume at.
+		struct Exit
+		{
+			int jump;
+			int resume;
+		};
+
+		// A slow path: the jumps of the fast path to it, the instruction
+		// it runs, where it goes on, and where to resume if it stops.
+		struct Slow_path
+		{
+			std::vector<int> jumps;
+			const Predecoded* entry;
+			int back;
+			int resume;
+		};
+
+		std::vector<Exit> exits{};
+		std::vector<Slow_path> slow_paths{};
+
+		// Call the thunk of the given kind, and stop unless it goes on.
+		// Direct calls are predicted without filling the branch target
+		// buffer, which thousands of indirect call sites would overflow.
+		const auto call = [&](Op_kind kind, int resume) {
+			e.mov(R::rdx, R::r13);
+			if (!e.call(reinterpret_cast<const void*>(thunks[kind]))) {
+				const int entry{kind * static_cast<int>(sizeof(Thunk))};
+				e.call(R::r14, static_cast<std::int8_t>(entry));
+			}
+			e.test8(R::rax);
+			exits.push_back(Exit{e.jump(R::zero), resume});
+		};
+
+		// Run the given instruction inline, with its slow path.
+		const auto run_inline = [&](const Predecoded* entry, int resume) {
+			Slow_path path{{}, entry, 0, resume};
+			emit_inline(e, layout, *entry, path.jumps);
+			path.back = e.size();
+			slow_paths.push_back(path);
+		};
+
+		// Five pushes after the return address align the stack for calls.
+		e.push(R::rbx);
+		e.push(R::r12);
+		e.push(R::r13);
+		e.push(R::r14);
+		e.push(R::r15);
+		e.mov(R::r12, R::rdi);
+		e.mov(R::rbx, immediate(ops));
+		e.mov(R::r13, immediate(&frame));
+		e.mov(R::r14, immediate(thunks));
+
+		for (int i = 0; i < block.num_ops; ++i) {
+			const Micro_op& op{ops[i]};
+			const int end{op.address + op.entry.length()};
+			if (op.entry.kind() == Op_kind::Fused) {
+				// Superinstructions only fuse instructions that can't
+				// fault, so they run inline whenever their parts do.
+				const Predecoded* fused{entries + op.address};
+				bool all_inline{true};
+				for (int k = 0; k < op.entry.length(); ++k)
+					all_inline = all_inline && runs_inline(layout, fused[k]);
+				if (all_inline) {
+					for (int k = 0; k < op.entry.length(); ++k)
+						run_inline(fused + k, op.address + k + 1);
+					continue;
+				}
+				e.mov(R::rdi, R::r12);
+				e.mov(R::rsi, immediate(fused));
+				call(Op_kind::Fused, end);
+			}
+			else if (runs_inline(layout, op.entry)) {
+				run_inline(&op.entry, end);
+			}
+			else {
+				e.mov(R::rdi, R::r12);
+				const int at{i * static_cast<int>(sizeof(Micro_op))
+							 + static_cast<int>(offsetof(Micro_op, entry))};
+				e.lea(R::rsi, R::rbx, at);
+				call(op.entry.kind(), end);
+			}
+		}
+		e.mov32(R::rax, block.start + block.length);
+		const int epilogue{e.size()};
+		e.pop(R::r15);
+		e.pop(R::r14);
+		e.pop(R::r13);
+		e.pop(R::r12);
+		e.pop(R::rbx);
+		e.ret();
+
+		// A slow path runs its instruction alone, through its thunk.
+		for (const Slow_path& path : slow_paths) {
+			for (int jump : path.jumps)
+				e.bind(jump, e.size());
+			e.mov(R::rdi, R::r12);
+			e.mov(R::rsi, immediate(path.entry));
+			call(thunk_kind(*path.entry), path.resume);
+			e.bind(e.jump(), path.back);
+		}
+
+		// Stopping after an operation resumes at the cell following it.
+		for (const Exit& exit : exits) {
+			e.bind(exit.jump, e.size());
+			e.mov32(R::rax, exit.resume);
+			e.bind(e.jump(), epilogue);
+		}
+
+		if (e.overflowed()) {
+			return nullptr;
+		}
+		Native_block native{reinterpret_cast<Native_block>(code + used)};
+		used += e.size();
+		return native;
+	}
+
+	/*
+	* Drop all native code.
+	* Parameters:
+	*	cache_epoch - Epoch of the block cache.
+	*/
+	void Jit::reset(long long cache_epoch)
+	{
+		for (Native_block& native : compiled)
+			native = nullptr;
+		used = 0;
+		epoch = cache_epoch;
+	}
+}
@@ -0,0 +1,122 @@
+#ifndef MIX_MACHINE_JIT_H
+#define MIX_MACHINE_JIT_H
+
+#include "Block_cache.h"
+#include "Byte.h"
+#include <exception>
+#include <vector>
+
+// Blocks compile to native code on x86-64 POSIX hosts. Elsewhere the
+// JIT compiles nothing, and every block stays interpreted.
+#if defined(__x86_64__) && defined(__unix__)
+#define MIX_JIT_SUPPORTED
+#endif
+
+namespace mix
+{
+	class Machine;
+
+	// Whether this build compiles blocks to native code.
+#ifdef MIX_JIT_SUPPORTED
+	constexpr bool JIT_SUPPORTED{true};
+#else
+	constexpr bool JIT_SUPPORTED{false};
+#endif
+
+	// Times a block is entered before it is compiled.
+	constexpr int JIT_THRESHOLD{8};
+
+	// Native code of a block: runs the block on the given machine,
+	// and returns the address to resume at.
+	using Native_block = int (*)(Machine*);
+
+	// State a compiled block checks after each operation.
+	struct Native_frame
+	{
+		// Machine end of program flag.
+		const bool* finished;
+
+		// Valid flag of the block.
+		const bool* valid;
+	};
+
+	// Where machine state lives, in bytes from the start of the machine,
+	// for the operations native code runs inline.
+	struct Native_layout
+	{
+		// Memory cells, or -1 if memory isn't a flat array of words.
+		int cells;
+
+		// Registers, and the overflow toggle.
+		int accumulator;
+		int extension;
+		int index;
+		int overflow;
+
+		// Decode cache flags and block cache cover counts, by address.
+		int decoded;
+		int covers;
+	};
+
+
+	// Compiler of hot translated blocks to native x86-64 code.
+	// Loads and stores of rA and rX, and binary additions and
+	// subtractions, run inline, superinstructions included. Other
+	// operations, and inline ones that would fault, read an invalid word
+	// or write over translated code, call their thunk, with the operands
+	// baked into the code, so nothing is looked up or dispatched between
+	// them. After a call the block stops, returning the address of the
+	// next cell, if the operation threw, finished the program or wrote
+	// over the block. Exceptions are caught before they reach native
+	// frames, and held until the machine takes them back.
+	// Code lives in one executable region, mapped writable only while a
+	// block is emitted. When it is full, or the block cache drops its
+	// blocks, all compiled code is dropped.
+	class Jit
+	{
+	public:
+		// Size of the executable region, in bytes.
+		static const int code_size{1 << 20};
+
+
+		// Constructors and destructor.
+		Jit(const bool*, int, const Native_layout&);
+		Jit(const Jit&) = delete;
+		~Jit();
+
+
+		/* Functions. */
+
+		// Compiling blocks.
+		Native_block find(int, long long) const;
+		Native_block compile(int, long long, const Block&,
+							 const Micro_op*, const Predecoded*);
+
+		// Running native code.
+		int run(Native_block, Machine*);
+		std::exception_ptr take_exception();
+
+
+	private:
+		// Executable region.
+		Byte* code;
+		int used;
+
+		// Native code and frame of each block, by block index.
+		std::vector<Native_block> compiled;
+		std::vector<Native_frame> frames;
+
+		// Block cache epoch the code was compiled in.
+		long long epoch;
+
+		// Machine end of program flag, and machine state layout.
+		const bool* finished;
+		Native_layout layout;
+
+		// Helper functions.
+		Native_block emit(const Block&, const Micro_op*, const Native_frame&,
+						  const Predecoded*);
+		void reset(long long);
+	};
+}
+#endif
@@ -24,22 +24,22 @@ namespace mix
 			mix_machine->accumulator(content);
 			break;
 		case Op_code::LD1N:
-			mix_machine->index_register(1, content);
+			mix_machine->store_index(1, content);
 			break;
 		case Op_code::LD2N:
-			mix_machine->index_register(2, content);
+			mix_machine->store_index(2, content);
 			break;
 		case Op_code::LD3N:
-			mix_machine->index_register(3, content);
+			mix_machine->store_index(3, content);
 			break;
 		case Op_code::LD4N:
-			mix_machine->index_register(4, content);
+			mix_machine->store_index(4, content);
 			break;
 		case Op_code::LD5N:
-			mix_machine->index_register(5, content);
+			mix_machine->store_index(5, content);
 			break;
 		case Op_code::LD6N:
-			mix_machine->index_register(6, content);
+			mix_machine->store_index(6, content);
 			break;
 		case Op_code::LDXN:
 			mix_machine->extension_register(content);
@@ -15,22 +15,22 @@ namespace mix
 			mix_machine->accumulator(content);
 			break;
 		case Op_code::LD1:
-			mix_machine->index_register(1, content);
+			mix_machine->store_index(1, content);
 			break;
 		case Op_code::LD2:
-			mix_machine->index_register(2, content);
+			mix_machine->store_index(2, content);
 			break;
 		case Op_code::LD3:
-			mix_machine->index_register(3, content);
+			mix_machine->store_index(3, content);
 			break;
 		case Op_code::LD4:
-			mix_machine->index_register(4, content);
+			mix_machine->store_index(4, content);
 			break;
 		case Op_code::LD5:
-			mix_machine->index_register(5, content);
+			mix_machine->store_index(5, content);
 			break;
 		case Op_code::LD6:
-			mix_machine->index_register(6, content);
+			mix_machine->store_index(6, content);
 			break;
 		case Op_code::LDX:
 			mix_machine->extension_register(content);
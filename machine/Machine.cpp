@@ -1,14 +1,38 @@
 #include "Machine.h"
-#include "Op_factory.h"
+#include "Decoder.h"
+#include "Op_specializations.h"
+#include "Op_table.h"
+#include "Operations.h"
+#include "Snapshot.h"
+#include "Superinstructions.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
 #include <iterator>
-#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Threaded dispatch uses computed goto where the compiler supports it.
+// Build with MIX_SWITCH_DISPATCH to force the portable switch.
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(MIX_SWITCH_DISPATCH)
+#define MIX_COMPUTED_GOTO
+#endif
 
 namespace mix
 {
+	namespace
+	{
+		// Entry of instructions fetched from outside memory.
+		const Predecoded outside_memory{
+			make_predecoded(decode_unindexed(Word{}), NO_HANDLER,
+							Op_kind::Unknown)
+		};
+	}
+
 	/* Constant definitions. */
-	const unsigned int Machine::mem_size{4000};
-	const unsigned int Machine::num_index_registers{6};
+	const unsigned int Machine::mem_size;
+	const unsigned int Machine::num_index_registers;
 
 	/*
 	* Construct a mix machine.
@@ -20,23 +44,42 @@ namespace mix
 		  jump{},
 		  accum{},
 		  exten{},
-		  index(num_index_registers),
-		  memory(mem_size),
-		  program_finished{false}
+		  index{},
+		  memory{},
+		  program_image{},
+		  decoded{},
+		  blocks{},
+		  program_finished{false},
+		  fault_state{Fault::None},
+		  jit_state{Jit_mode::Off},
+		  jit{},
+		  reference{}
 	{
 	}
 
 	/*
 	* Start the machine with the given arguments.
+	* If a snapshot file is given, the final state is saved to it, also
+	* when the program ends with a fault.
 	* Parameters:
-	*	args - Machine arguments.
+	*	args - Machine arguments: the program file, then optionally
+	*		the snapshot file.
 	*/
 	void Machine::start(std::vector<std::string>& args)
 	{
 		check_arguments(args);
 		std::ifstream program_file{args[0]};
 		load_program(&program_file);
-		run_program();
+		try {
+			run_program();
+		}
+		catch (std::invalid_argument&) {
+			if (args.size() > 1)
+				save_snapshot(args[1]);
+			throw;
+		}
+		if (args.size() > 1)
+			save_snapshot(args[1]);
 	}
 
 	/*
@@ -52,78 +95,671 @@ namespace mix
 	}
 
 	/*
-	* Loads a program into memory.
+	* Loads a program into memory, as by loading its image: every cell
+	* after the program is cleared to +0, not left as it was.
 	* Parameters:
-	*	filename - Name of program file.
+	*	program - Stream to read the program from.
 	*/
 	void Machine::load_program(std::istream* program)
 	{
-		check_program_input_stream(program);
-		int curr_address{0};
-		std::istream_iterator<Word> instruction_iter{*program};
-		std::istream_iterator<Word> eof{};
-		while (instruction_iter != eof) {
-			if (!instruction_iter->is_valid()) {
-				throw Invalid_basic_word{};
-			}
-			memory[curr_address++] = *instruction_iter;
-			++instruction_iter;
-		}
+		load_program(Program_image{program});
+	}
+
+	/*
+	* Loads the given program image as the whole memory: the image's
+	* cells replace the program's, and every cell after the program is
+	* cleared to +0, whatever it held before. Data a caller wrote before
+	* loading is lost, so it must be written after. Sharing the image's
+	* cells, and with paged memory its pages, needs the whole memory to
+	* come from the image. The machine keeps a reference to the image,
+	* which reset restores.
+	* Parameters:
+	*	image - Program image.
+	*/
+	void Machine::load_program(const Program_image& image)
+	{
+		memory = image.memory();
+		program_image = image;
+		decoded.invalidate_all();
+		blocks.invalidate_all();
 	}
 
 	/*
-	* Check the program file.
-	* If the file cannot be opened, throws an exception.
-	* If the file is empty, throws an exception.
+	* Reset the machine to its power-on state, in place: registers,
+	* flags, program counter and faults are cleared, and memory is
+	* cleared or restored to the last loaded program. Only the cells that
+	* differ are rewritten, so the predecoded instructions, translated
+	* blocks and native code of an unchanged program stay warm. The JIT
+	* mode is kept, and so is the last loaded program, which a later
+	* reset can still restore.
+	* Parameters:
+	*	mode - Whether to keep the last loaded program in memory.
 	*/
-	void Machine::check_program_input_stream
-			(std::istream* program_input_stream) const
+	void Machine::reset(Reset_mode mode)
 	{
-		if (program_input_stream->fail()) {
-			throw std::invalid_argument{"Cannot read program"};
+		pc = 0;
+		overflow = Bit::Off;
+		compare = Comparison_value::Equal;
+		jump = Half_word{};
+		accum = Word{};
+		exten = Word{};
+		index.fill(Half_word{});
+		program_finished = false;
+		fault_state = Fault::None;
+
+		if (mode == Reset_mode::Keep_program) {
+			restore_memory(program_image.memory());
 		}
-		if (program_input_stream->peek() == EOF) {
-			throw std::invalid_argument{"Program file is empty"};
+		else {
+			static const Memory blank{};
+			restore_memory(blank);
+		}
+	}
+
+	/*
+	* Returns a new machine in the same state as this one: memory,
+	* registers, flags, program counter, loaded program and JIT mode.
+	* Both machines then run on their own. The memory is copied whole,
+	* all mem_size cells, in the default and split layouts; only a build
+	* with paged memory ("make paged_memory=1") shares the pages of this
+	* machine, copying a page when either machine first writes to it.
+	* The clone starts with empty decode and block caches.
+	*/
+	std::unique_ptr<Machine> Machine::clone() const
+	{
+		std::unique_ptr<Machine> copy{std::make_unique<Machine>()};
+		copy_state(*copy);
+		copy->program_image = program_image;
+		copy->jit_mode(jit_state);
+		return copy;
+	}
+
+	/*
+	* Restore memory to the given image, invalidating the cells that
+	* differ from it.
+	* Parameters:
+	*	image - Memory to restore.
+	*/
+	void Machine::restore_memory(const Memory& image)
+	{
+		for (int address = memory.first_difference(image);
+				address < static_cast<int>(mem_size);
+				address = memory.first_difference(image, address + 1)) {
+			memory[address] = image[address];
+			decoded.invalidate(address);
+			blocks.invalidate(address);
 		}
 	}
 
 	/*
 	* Runs the program currently loaded in memory.
+	* Straight-line runs of cells are translated into blocks of
+	* predecoded micro-ops, and each block chains straight into the one
+	* following it. The dispatcher only looks blocks up again when a
+	* chain breaks: when the program faults, when it writes over the block
+	* it is running, or when the next cell can't start a block. Cells that
+	* can't start a block are executed one at a time.
 	*/
 	void Machine::run_program()
 	{
+		program_finished = false;
+		fault_state = Fault::None;
 		pc = 0; // Start program counter at first memory cell.
+		dispatch();
+	}
+
+	/*
+	* Runs the program currently loaded in memory, starting with its
+	* translation. The interpreter takes over where the translation
+	* returns, unless the program faulted.
+	* Parameters:
+	*	program - Translation of the program.
+	*/
+	void Machine::run_program(Translated_program program)
+	{
 		program_finished = false;
+		fault_state = Fault::None;
+		int next{0};
+		try {
+			program(*this, next);
+		}
+		catch (...) {
+			pc = next;
+			throw;
+		}
+		pc = next;
+		dispatch();
+	}
+
+	/*
+	* Runs blocks, or single instructions, from the program counter
+	* until the program finishes.
+	*/
+	void Machine::dispatch()
+	{
 		while (!program_finished) {
-			execute_next_instruction();
+			const int block{
+				static_cast<unsigned int>(pc) < mem_size ?
+					lookup_block(pc) : blocks.no_block
+			};
+			if (block == blocks.no_block) {
+				execute_next_instruction();
+			}
+			else if (jit) {
+				run_jit(block);
+			}
+			else {
+				run_blocks(block);
+			}
 		}
 	}
 
+	/*
+	* Runs the given block, and the blocks chained after it, until the
+	* chain breaks. Micro-ops are dispatched as threaded code: every
+	* operation ends by dispatching the next micro-op itself, so each one
+	* has its own indirect branch to predict. Superinstructions run all
+	* the cells they fuse at once. Micro-ops with a specialized handler
+	* call it straight from their entry. For the others, the operation
+	* type is known at each dispatch site, so their calls bind statically.
+	* The program counter is written when the chain breaks, or when an
+	* operation throws. With the JIT on, only the given block is run,
+	* so the JIT decides how to run the next one.
+	* Parameters:
+	*	index - Index of a valid block.
+	*/
+	void Machine::run_blocks(int index)
+	{
+		const Block* block{&blocks[index]};
+		const Micro_op* op{blocks.ops(*block)};
+		const Micro_op* end{op + block->num_ops};
+		Instruction inst{};
+		try {
+#ifdef MIX_COMPUTED_GOTO
+			static const void* const labels[]{
+				&&unknown, &&math, &&shift, &&load, &&load_neg, &&store,
+				&&specialized, &&fused
+			};
+
+// Stop if the program finished or wrote over its block, else jump
+// to the next micro-op, or chain to the next block at the end.
+#define MIX_DISPATCH() \
+			if (program_finished || !block->valid) \
+				goto stopped; \
+			if (++op == end) \
+				goto chained; \
+			goto *labels[op->entry.kind()]
+
+			goto *labels[op->entry.kind()];
+		fused:
+			Superinstructions::handler(op->entry.fused)(
+				this, &decoded[op->address]);
+			MIX_DISPATCH();
+		specialized:
+			Op_specializations::handler(op->entry.handler)(this, op->entry);
+			MIX_DISPATCH();
+		unknown:
+			indexed(op->entry, inst);
+			Op_table::execute_unknown(this, inst);
+			MIX_DISPATCH();
+		math:
+			indexed(op->entry, inst);
+			Math_operation{}.execute(this, inst);
+			MIX_DISPATCH();
+		shift:
+			indexed(op->entry, inst);
+			Shift_operation{}.execute(this, inst);
+			MIX_DISPATCH();
+		load:
+			indexed(op->entry, inst);
+			Load_operation{}.execute(this, inst);
+			MIX_DISPATCH();
+		load_neg:
+			indexed(op->entry, inst);
+			Load_neg_operation{}.execute(this, inst);
+			MIX_DISPATCH();
+		store:
+			indexed(op->entry, inst);
+			Store_operation{}.execute(this, inst);
+			MIX_DISPATCH();
+		chained:
+			pc = block->start + block->length;
+			if (jit) {
+				return;
+			}
+			index = chain(index);
+			if (index == blocks.no_block) {
+				return;
+			}
+			block = &blocks[index];
+			op = blocks.ops(*block);
+			end = op + block->num_ops;
+			goto *labels[op->entry.kind()];
+		stopped:
+			pc = op->address + op->entry.length();
+#undef MIX_DISPATCH
+#else
+			for (;;) {
+				for (; op != end; ++op) {
+					execute(*op, inst);
+					if (program_finished || !block->valid) {
+						pc = op->address + op->entry.length();
+						return;
+					}
+				}
+				pc = block->start + block->length;
+				if (jit) {
+					return;
+				}
+				index = chain(index);
+				if (index == blocks.no_block) {
+					return;
+				}
+				block = &blocks[index];
+				op = blocks.ops(*block);
+				end = op + block->num_ops;
+			}
+#endif
+		}
+		catch (...) {
+			pc = op->address + op->entry.length();
+			throw;
+		}
+	}
+
+	/*
+	* Execute the given micro-op.
+	* Parameters:
+	*	op - Micro-op of a valid block.
+	*	inst - Instruction to decode into.
+	*/
+	void Machine::execute(const Micro_op& op, Instruction& inst)
+	{
+		switch (op.entry.kind())
+		{
+		case Op_kind::Fused:
+			Superinstructions::handler(op.entry.fused)(
+				this, &decoded[op.address]);
+			break;
+		case Op_kind::Specialized:
+			Op_specializations::handler(op.entry.handler)(this, op.entry);
+			break;
+		case Op_kind::Math:
+			indexed(op.entry, inst);
+			Math_operation{}.execute(this, inst);
+			break;
+		case Op_kind::Shift:
+			indexed(op.entry, inst);
+			Shift_operation{}.execute(this, inst);
+			break;
+		case Op_kind::Load:
+			indexed(op.entry, inst);
+			Load_operation{}.execute(this, inst);
+			break;
+		case Op_kind::Load_neg:
+			indexed(op.entry, inst);
+			Load_neg_operation{}.execute(this, inst);
+			break;
+		case Op_kind::Store:
+			indexed(op.entry, inst);
+			Store_operation{}.execute(this, inst);
+			break;
+		default:
+			indexed(op.entry, inst);
+			Op_table::execute_unknown(this, inst);
+			break;
+		}
+	}
+
+	/*
+	* Returns the index of the block starting at the given address,
+	* translating it if needed, or no_block if no block can start there.
+	* Parameters:
+	*	address - Memory address, in range [0, mem_size).
+	*/
+	int Machine::lookup_block(int address)
+	{
+		const int index{blocks.find(address)};
+		if (index == blocks.no_block) {
+			return translate(address);
+		}
+		++blocks.stats().hits;
+		return index;
+	}
+
+	/*
+	* Translate the straight-line run of cells starting at the given
+	* address into a block, and return its index. The block ends after
+	* an unknown operation, since it always faults, before a cell that
+	* doesn't decode, or at MAX_BLOCK_LENGTH cells. If the first cell
+	* doesn't decode, there is no block and no_block is returned.
+	* Parameters:
+	*	start - Memory address, in range [0, mem_size).
+	*/
+	int Machine::translate(int start)
+	{
+		const int index{blocks.open(start)};
+		int address{start};
+		while (address < static_cast<int>(mem_size)
+				&& is_decodable(std::as_const(memory)[address])) {
+			const Predecoded& entry{predecode(address)};
+			if (start + MAX_BLOCK_LENGTH < address + entry.length()) {
+				break;
+			}
+			blocks.append({entry, address});
+			address += entry.length();
+			if (entry.kind() == Op_kind::Unknown) {
+				break;
+			}
+		}
+		return blocks.close(index, address - start);
+	}
+
+	/*
+	* Returns the index of the block following the given one, or
+	* no_block if there is none. The first time, the following block is
+	* looked up, or translated, and linked; after that the link is
+	* followed for as long as the following block is valid.
+	* Parameters:
+	*	index - Index of a valid block.
+	*/
+	int Machine::chain(int index)
+	{
+		const Block& block{blocks[index]};
+		if (block.next != blocks.no_block && blocks[block.next].valid) {
+			++blocks.stats().hits;
+			++blocks.stats().chained;
+			return block.next;
+		}
+		const int next_start{block.start + block.length};
+		if (static_cast<int>(mem_size) <= next_start) {
+			return blocks.no_block;
+		}
+
+		// Translating may flush the cache, and the block with it.
+		const long long flushes{blocks.stats().flushes};
+		const int next{lookup_block(next_start)};
+		if (next != blocks.no_block && blocks.stats().flushes == flushes) {
+			blocks.link(index, next);
+		}
+		return next;
+	}
+
+	/*
+	* Runs the given block, and the blocks chained after it, until the
+	* chain breaks. Hot blocks run their native code; cold blocks, and
+	* blocks the JIT can't compile, are interpreted.
+	* Parameters:
+	*	index - Index of a valid block.
+	*/
+	void Machine::run_jit(int index)
+	{
+		for (;;) {
+			const Block& block{blocks[index]};
+			const int end{block.start + block.length};
+			const Native_block code{native(index)};
+			if (!code) {
+				run_blocks(index);
+			}
+			else if (jit_state == Jit_mode::Differential) {
+				run_differential(index, code);
+			}
+			else {
+				pc = jit->run(code, this);
+				if (const std::exception_ptr e{jit->take_exception()}) {
+					std::rethrow_exception(e);
+				}
+			}
+			if (program_finished || pc != end) {
+				return;
+			}
+			index = chain(index);
+			if (index == blocks.no_block) {
+				return;
+			}
+		}
+	}
+
+	/*
+	* Returns the native code of the given block, compiling it once it
+	* has been entered JIT_THRESHOLD times, or null if it has none yet.
+	* A block rewritten by its program is translated again, and starts
+	* counting over, so self-modifying code seldom gets hot and stays
+	* interpreted.
+	* Parameters:
+	*	index - Index of a valid block.
+	*/
+	Native_block Machine::native(int index)
+	{
+		const long long epoch{blocks.epoch()};
+		Native_block code{jit->find(index, epoch)};
+		if (!code && blocks.enter(index) == JIT_THRESHOLD) {
+			const Block& block{blocks[index]};
+			code = jit->compile(index, epoch, block, blocks.ops(block),
+								&decoded[0]);
+			if (code) {
+				++blocks.stats().compiled;
+			}
+		}
+		return code;
+	}
+
+	/*
+	* Run the native code of the given block, and check the result
+	* against the reference engine: a copy of the machine, taken before
+	* the run, executing the same instructions one at a time. If the
+	* results differ, throws an exception.
+	* Parameters:
+	*	index - Index of a valid block.
+	*	code - Native code of the block.
+	*/
+	void Machine::run_differential(int index, Native_block code)
+	{
+		if (!reference) {
+			reference = std::make_unique<Machine>();
+		}
+		copy_state(*reference);
+
+		pc = jit->run(code, this);
+		const std::exception_ptr native_exception{jit->take_exception()};
+
+		bool reference_threw{false};
+		try {
+			const int length{blocks[index].length};
+			for (int i = 0; i < length && reference->pc != pc
+					&& !reference->program_finished; ++i) {
+				reference->execute_next_instruction();
+			}
+		}
+		catch (...) {
+			reference_threw = true;
+		}
+		if (!same_state(*reference)
+				|| reference_threw != static_cast<bool>(native_exception)) {
+			throw std::runtime_error{"Native code differs from interpreter"};
+		}
+		if (native_exception) {
+			std::rethrow_exception(native_exception);
+		}
+	}
+
+	/*
+	* Copy the state of this machine into the given one: memory,
+	* registers, flags and program counter.
+	* Parameters:
+	*	other - Machine to copy into.
+	*/
+	void Machine::copy_state(Machine& other) const
+	{
+		other.pc = pc;
+		other.overflow = overflow;
+		other.compare = compare;
+		other.jump = jump;
+		other.accum = accum;
+		other.exten = exten;
+		other.index = index;
+		other.memory = memory;
+		other.decoded.invalidate_all();
+		other.blocks.invalidate_all();
+		other.program_finished = program_finished;
+		other.fault_state = fault_state;
+	}
+
+	/*
+	* Returns whether the given machine has the same state as this one:
+	* memory, registers, flags and program counter.
+	* Parameters:
+	*	other - Machine to compare to.
+	*/
+	bool Machine::same_state(const Machine& other) const
+	{
+		return pc == other.pc
+			&& overflow == other.overflow
+			&& compare == other.compare
+			&& jump == other.jump
+			&& accum == other.accum
+			&& exten == other.exten
+			&& index == other.index
+			&& program_finished == other.program_finished
+			&& fault_state == other.fault_state
+			&& memory.first_difference(other.memory) == mem_size;
+	}
+
 	/*
 	* Execute the next instruction.
 	*/
 	void Machine::execute_next_instruction()
 	{
 		// Fetch, decode, and increment program counter.
-		const Instruction next{decode(memory_cell(pc++))};
+		const Predecoded& next{predecode(pc++)};
 
-		// Execute.
-		std::unique_ptr<Operation> op{Op_factory::make(next.op_code)};
-		op->execute(this, next);
+		// Execute, a single instruction even if it starts a superinstruction.
+		if (next.handler != NO_HANDLER) {
+			Op_specializations::handler(next.handler)(this, next);
+			return;
+		}
+		Instruction inst{};
+		indexed(next, inst);
+		Op_table::handler(inst.op_code)(this, inst);
 	}
 
 	/*
 	* Decode the word as an instruction.
 	*/
-	Instruction Machine::decode(const Word& word) const
+	Instruction Machine::decode(const Word& word)
 	{
-		return Instruction{
-			read_address(word),
-			get_index_spec(word),
-			get_field_spec(word),
-			get_modification(word),
-			get_op_code(word)
+		Instruction inst{decode_unindexed(word)};
+		apply_index(inst);
+		return inst;
+	}
+
+	/*
+	* Returns the predecoded instruction at the given address.
+	* The cell is decoded once, with a specialized handler if the
+	* instruction has one, and with a superinstruction if it starts one.
+	* The entry is cached until the cell, or a cell it fuses, is written.
+	* Out of range addresses decode as +0.
+	* Parameters:
+	*	address - Memory address of the instruction.
+	*/
+	const Predecoded& Machine::predecode(int address)
+	{
+		if (!in_memory(address)) {
+			return outside_memory;
+		}
+		if (!decoded.is_decoded(address)) {
+			fill_decoded(address);
+			fuse(address);
+		}
+		return decoded[address];
+	}
+
+	/*
+	* Decode the cell at the given address into its cache entry,
+	* without looking for a superinstruction.
+	* Cells are decoded by table. Words with an invalid field, sign or
+	* byte get the handler trapping them, so decoding never throws.
+	* Parameters:
+	*	address - Memory address, in range [0, mem_size).
+	*/
+	void Machine::fill_decoded(int address)
+	{
+		const Decoded_instruction table_decoded{
+			Decoder::decode(std::as_const(memory)[address])
+		};
+		if (table_decoded.status == Decode_status::Invalid_word
+				|| table_decoded.status == Decode_status::Invalid_field) {
+			decoded.fill(address, make_predecoded(
+				table_decoded,
+				Op_specializations::INVALID_HANDLER,
+				Op_kind::Specialized
+			));
+			return;
+		}
+		const Byte handler{
+			Op_specializations::find(Decoder::to_instruction(table_decoded))
+		};
+		decoded.fill(address, make_predecoded(
+			table_decoded,
+			handler,
+			handler != NO_HANDLER ? Op_kind::Specialized : table_decoded.kind
+		));
+	}
+
+	/*
+	* Make the decoded cell at the given address start a superinstruction,
+	* if it and the cells following it form one. The cells it fuses are
+	* decoded too, but don't start superinstructions of their own.
+	* Parameters:
+	*	address - Memory address, in range [0, mem_size).
+	*/
+	void Machine::fuse(int address)
+	{
+		const int available{static_cast<int>(mem_size) - address};
+		const int count{available < MAX_FUSED_LENGTH ?
+						available : MAX_FUSED_LENGTH};
+		Word cells[MAX_FUSED_LENGTH];
+		for (int i = 0; i < count; ++i) {
+			cells[i] = std::as_const(memory)[address + i];
+		}
+		const Superinstructions::Fusion fusion{
+			Superinstructions::find(cells, count)
 		};
+		if (fusion.handler == NO_HANDLER) {
+			return;
+		}
+		for (int a = address + 1; a < address + fusion.length; ++a) {
+			if (!decoded.is_decoded(a)) {
+				fill_decoded(a);
+			}
+		}
+		decoded.fuse(address, fusion.handler, fusion.length);
+	}
+
+	/*
+	* Copy the instruction of the given entry into the given one, with
+	* its address offset by its index register.
+	* Parameters:
+	*	entry - Predecoded instruction.
+	*	inst - Instruction to copy into.
+	*/
+	void Machine::indexed(const Predecoded& entry, Instruction& inst)
+	{
+		inst = entry.instruction();
+		apply_index(inst);
+	}
+
+	/*
+	* Offset the address of the given instruction by the contents
+	* of its index register, if it specifies one.
+	* Parameters:
+	*	inst - Instruction with an unindexed address.
+	*/
+	void Machine::apply_index(Instruction& inst)
+	{
+		if (inst.index_spec != 0) {
+			inst.address += get_address(fetch_index(inst.index_spec));
+		}
 	}
 
 	/*
@@ -133,12 +769,12 @@ namespace mix
 	* Parameters:
 	*	instruction - Instruction to read address from.
 	*/
-	int Machine::read_address(const Word& instruction) const
+	int Machine::read_address(const Word& instruction)
 	{
 		int address{get_address(instruction)};
 		int index_spec{get_index_spec(instruction)};
 		if (index_spec != 0) {
-			address += get_address(index_register(index_spec));
+			address += get_address(fetch_index(index_spec));
 		}
 		return address;
 	}
@@ -152,9 +788,81 @@ namespace mix
 	*/
 	const Word Machine::memory_content(
 			int address,
-			const Field_spec& field) const
+			const Field_spec& field)
+	{
+		return fetch(address).field_aligned_right(field);
+	}
+
+	/*
+	* Trap the given fault.
+	* The checked engine throws. The unchecked engine records the fault
+	* and stops the running program.
+	* Parameters:
+	*	f - Fault to trap.
+	*	message - Description of the fault.
+	*/
+	void Machine::trap(Fault f, const char* message)
+	{
+		if (CHECKED_ACCESS) {
+			throw std::invalid_argument{message};
+		}
+		fault_state = f;
+		program_finished = true;
+	}
+
+	/*
+	* Set the program counter to the given address.
+	* Parameters:
+	*	address - Address of the next instruction, in range [0, mem_size).
+	*/
+	void Machine::program_counter(int address)
+	{
+		check_memory_cell_address(address);
+		pc = address;
+	}
+
+	/*
+	* Set the JIT mode. Turning the JIT off drops all native code.
+	* Parameters:
+	*	mode - New JIT mode.
+	*/
+	void Machine::jit_mode(Jit_mode mode)
 	{
-		return memory_cell(address).field_aligned_right(field);
+		jit_state = mode;
+		if (mode == Jit_mode::Off) {
+			jit.reset();
+			reference.reset();
+		}
+		else if (!jit) {
+			jit = std::make_unique<Jit>(&program_finished, mem_size,
+										native_layout());
+		}
+	}
+
+	/*
+	* Returns where the machine's state lives, for native code.
+	* Only flat memory is laid out as an array of words.
+	*/
+	Native_layout Machine::native_layout() const
+	{
+		const auto offset = [this](const void* p) {
+			return static_cast<int>(static_cast<const char*>(p)
+									- reinterpret_cast<const char*>(this));
+		};
+#if defined(MIX_SPLIT_MEMORY) || defined(MIX_PAGED_MEMORY)
+		const int cells{-1};
+#else
+		const int cells{offset(memory.data())};
+#endif
+		return Native_layout{
+			cells,
+			offset(&accum),
+			offset(&exten),
+			offset(index.data()),
+			offset(&overflow),
+			offset(decoded.decoded_flags()),
+			offset(blocks.cover_counts())
+		};
 	}
 
 	/*
@@ -198,7 +906,7 @@ namespace mix
 	* Parameters:
 	*	register_num - Index register number.
 	*/
-	Half_word Machine::index_register(int register_num) const
+	const Half_word& Machine::index_register(int register_num) const
 	{
 		check_index_register_number(register_num);
 		return index[register_num - 1];
@@ -206,12 +914,167 @@ namespace mix
 
 	/*
 	* Dumps the contents of memory into the given stream.
+	* The whole image is formatted into one buffer, then written at once.
 	*/
 	void Machine::dump_memory(std::ostream* stream) const
 	{
-		for (int i = 0; i < mem_size; ++i) {
-			*stream << memory[i];
+		std::string image(mem_size * WORD_IMAGE_SIZE, '\0');
+		memory.write_image(&image[0]);
+		stream->write(image.data(), image.size());
+	}
+
+	/*
+	* Returns the first memory address, starting at from, whose contents
+	* differ from the same address in the given machine, or mem_size
+	* if the memories are identical from there on.
+	* Parameters:
+	*	other - Machine to compare to.
+	*	from - First address to compare.
+	*/
+	int Machine::first_memory_difference(const Machine& other, int from) const
+	{
+		check_memory_cell_address(from);
+		return memory.first_difference(other.memory, from);
+	}
+
+	/*
+	* Writes the integer value of every memory cell, in address order.
+	* Parameters:
+	*	values - Buffer of mem_size integers.
+	*/
+	void Machine::export_memory(long long* values) const
+	{
+		memory.to_ints(values);
+	}
+
+	/*
+	* Sets every memory cell, in address order, from integer values.
+	* If a value doesn't fit in a word, throws an exception, and memory
+	* is left as it was.
+	* Parameters:
+	*	values - Buffer of mem_size integers.
+	*/
+	void Machine::import_memory(const long long* values)
+	{
+		memory.from_ints(values);
+		decoded.invalidate_all();
+		blocks.invalidate_all();
+	}
+
+	/*
+	* Save a binary snapshot of the architectural state of the machine
+	* to the file at the given path: program counter, registers, flags
+	* and memory. The snapshot replaces the file whole, so a failed save
+	* keeps the last snapshot saved at the path.
+	* If the file can't be written, throws an exception.
+	* Parameters:
+	*	path - Path of the snapshot file.
+	*/
+	void Machine::save_snapshot(const std::string& path) const
+	{
+		Snapshot::Header header{};
+		std::copy(std::begin(Snapshot::magic), std::end(Snapshot::magic),
+				  header.magic);
+		header.version = Snapshot::version;
+		header.header_size = sizeof(Snapshot::Header);
+		header.radix = Word::byte_model::radix;
+		header.num_bytes = Word::num_bytes;
+		header.mem_size = mem_size;
+		header.num_devices = 0;
+		header.pc = pc;
+		header.accumulator = accum.packed();
+		header.extension = exten.packed();
+		header.jump = jump.packed();
+		for (unsigned int i = 0; i < num_index_registers; ++i)
+			header.index[i] = index[i].packed();
+		header.overflow = static_cast<std::uint8_t>(overflow);
+		header.compare = static_cast<std::uint8_t>(compare);
+
+		std::vector<Word::Packed> cells(mem_size);
+		memory.to_packed(cells.data());
+		Snapshot::write(path, header, cells.data(), cells.size());
+	}
+
+	/*
+	* Restore the architectural state of the machine from the binary
+	* snapshot at the given path. The snapshot is checked before any
+	* state changes, so a rejected snapshot leaves the machine as it
+	* was. Faults are cleared, and the loaded program is kept.
+	* The program counter may be mem_size, one past the last cell: a
+	* program that ends by faulting at the last cell is saved that way,
+	* and resuming it traps at once, fetching outside memory.
+	* If the file can't be read, isn't a snapshot of this machine in
+	* this format version, or holds a program counter outside
+	* [0, mem_size] or a word no register or cell can hold, throws an
+	* exception.
+	* Parameters:
+	*	path - Path of the snapshot file.
+	*/
+	void Machine::restore_snapshot(const std::string& path)
+	{
+		const Mapped_file file{path};
+		Snapshot::Header header{};
+		if (file.size() < sizeof(header)) {
+			throw std::invalid_argument{"Not a machine snapshot"};
+		}
+		std::memcpy(&header, file.data(), sizeof(header));
+		if (!std::equal(std::begin(Snapshot::magic),
+						std::end(Snapshot::magic), header.magic)) {
+			throw std::invalid_argument{"Not a machine snapshot"};
+		}
+		if (header.version != Snapshot::version
+				|| header.header_size != sizeof(header)
+				|| header.num_devices != 0) {
+			throw std::invalid_argument{"Unsupported snapshot version"};
+		}
+		if (header.radix != Word::byte_model::radix
+				|| header.num_bytes != Word::num_bytes
+				|| header.mem_size != mem_size
+				|| file.size() != Snapshot::size(mem_size)) {
+			throw std::invalid_argument{"Snapshot of a different machine"};
+		}
+		if (static_cast<Bit>(header.overflow) != Bit::On
+				&& static_cast<Bit>(header.overflow) != Bit::Off) {
+			throw std::invalid_argument{"Invalid snapshot overflow bit"};
+		}
+		if (Comparison_value::Less
+				< static_cast<Comparison_value>(header.compare)) {
+			throw std::invalid_argument{"Invalid snapshot comparison"};
+		}
+		// One past the last cell is where a program faulting there ends.
+		if (header.pc < 0 || static_cast<int>(mem_size) < header.pc) {
+			throw std::invalid_argument{"Invalid snapshot program counter"};
+		}
+		bool registers_valid{
+			Word::is_packed(header.accumulator)
+			&& Word::is_packed(header.extension)
+			&& Half_word::is_packed(header.jump)
+		};
+		for (unsigned int i = 0; i < num_index_registers; ++i)
+			registers_valid &= Half_word::is_packed(header.index[i]);
+		if (!registers_valid) {
+			throw std::invalid_argument{"Invalid snapshot register"};
 		}
+		const Word::Packed* cells{reinterpret_cast<const Word::Packed*>(
+			file.data() + sizeof(header))};
+		if (!std::all_of(cells, cells + mem_size, Word::is_packed)) {
+			throw std::invalid_argument{"Invalid snapshot memory"};
+		}
+
+		pc = header.pc;
+		accum = Word::from_packed(header.accumulator);
+		exten = Word::from_packed(header.extension);
+		jump = Half_word::from_packed(header.jump);
+		for (unsigned int i = 0; i < num_index_registers; ++i)
+			index[i] = Half_word::from_packed(header.index[i]);
+		overflow = static_cast<Bit>(header.overflow);
+		compare = static_cast<Comparison_value>(header.compare);
+		program_finished = false;
+		fault_state = Fault::None;
+
+		memory.from_packed(cells);
+		decoded.invalidate_all();
+		blocks.invalidate_all();
 	}
 
 	/*
@@ -219,7 +1082,7 @@ namespace mix
 	* Parameters:
 	*	address - Memory address, in range [0, mem_size].
 	*/
-	Word Machine::memory_cell(int address) const
+	Memory::const_reference Machine::memory_cell(int address) const
 	{
 		check_memory_cell_address(address);
 		return memory[address];
@@ -247,26 +1110,8 @@ namespace mix
 	{
 		check_memory_cell_address(address);
 		memory[address] = w;
-	}
-
-	/*
-	* Load the accumulator with the given word.
-	* Parameters:
-	*	w - Word to load into accumulator.
-	*/
-	void Machine::accumulator(const Word& w)
-	{
-		accum = w;
-	}
-
-	/*
-	* Load the extension register with the given word.
-	* Parameters:
-	*	w - Word to load into extension register.
-	*/
-	void Machine::extension_register(const Word& w)
-	{
-		exten = w;
+		decoded.invalidate(address);
+		blocks.invalidate(address);
 	}
 
 	/*
@@ -1,21 +1,40 @@
 #ifndef MIX_MACHINE_MACHINE_H
 #define MIX_MACHINE_MACHINE_H
 
+#include "Access_policy.h"
 #include "Basic_word.h"
+#include "Block_cache.h"
+#include "Decode_cache.h"
 #include "Field_spec.h"
 #include "Instruction.h"
+#include "Jit.h"
+#include "Memory_layout.h"
 #include "Op_code.h"
+#include "Program_image.h"
 #include "Sign.h"
 #include "Word.h"
+#include <array>
 #include <functional>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
 namespace mix
 {
-	// Mix machine.
+	class Machine;
+
+	// A program translated ahead of time into native code. It runs the
+	// program from cell 0 on the given machine, keeping the given address
+	// at the cell following the instruction being executed. It returns
+	// when the program faults, or with the address at the cell where the
+	// interpreter takes over.
+	using Translated_program = void (*)(Machine&, int&);
+
+	// Mix machine. It isn't a template: its words are the Word of the
+	// byte model chosen at build time, so binary and decimal machines
+	// can't coexist in one process.
 	class Machine
 	{
 	public:
@@ -25,9 +44,25 @@ namespace mix
 		// Comparison values
 		enum class Comparison_value : Byte { Equal, Greater, Less };
 
+		// Faults trapped by the unchecked engine. Field faults are
+		// instructions with an invalid field, word faults instructions
+		// with an invalid sign or byte, and shift faults shifts by a
+		// negative amount.
+		enum class Fault : Byte {
+			None, Address, Index_register, Op_code, Field, Word, Shift
+		};
+
+		// JIT modes: off, compiling hot blocks, or compiling hot blocks
+		// and checking each native run against the interpreter.
+		enum class Jit_mode : Byte { Off, On, Differential };
+
+		// Reset modes: back to power-on state, or to power-on state with
+		// the last loaded program back in memory.
+		enum class Reset_mode : Byte { Power_on, Keep_program };
+
 		// Constants.
-		static const unsigned int mem_size;
-		static const unsigned int num_index_registers;
+		static const unsigned int mem_size{Memory::num_cells};
+		static const unsigned int num_index_registers{6};
 
 
 		// Constructors and destructor.
@@ -41,33 +76,61 @@ namespace mix
 		// Running the machine.
 		void start(std::vector<std::string>&);
 		void load_program(std::istream*);
+		void load_program(const Program_image&);
+		void reset(Reset_mode mode = Reset_mode::Power_on);
+		std::unique_ptr<Machine> clone() const;
 		void run_program();
+		void run_program(Translated_program);
 		void execute_next_instruction();
-		int read_address(const Word&) const;
+		int read_address(const Word&);
 		void dump_memory(std::ostream*) const;
-		Instruction decode(const Word&) const;
+		int first_memory_difference(const Machine&, int from = 0) const;
+		void export_memory(long long*) const;
+		void import_memory(const long long*);
+		void save_snapshot(const std::string&) const;
+		void restore_snapshot(const std::string&);
+		Instruction decode(const Word&);
 
 		// Executing instructions.
-		const Word memory_content(int, const Field_spec&) const;
+		const Word memory_content(int, const Field_spec&);
+
+		// Engine access, checked according to the access policy.
+		// Reads return references where the memory layout allows, and
+		// fields are written in place, so no state is copied.
+		Memory::const_reference fetch(int);
+		void store(int, const Word&);
+		void store_field(int, const Word&, const Field_spec&);
+		const Half_word& fetch_index(int);
+		void store_index(int, const Half_word&);
+		void trap(Fault, const char*);
+
+		// Register views, for updating registers in place.
+		Word& accumulator_ref() { return accum; }
+		Word& extension_register_ref() { return exten; }
 
 
 		// Accessors.
 		int program_counter() const { return pc; }
 		Bit overflow_bit() const { return overflow; }
 		Comparison_value comparison_indicator() const { return compare; }
-		Half_word jump_register() const { return jump; }
-		Word accumulator() const { return accum; }
-		Word extension_register() const { return exten; }
-		Half_word index_register(int) const;
-		Word memory_cell(int) const;
+		Fault fault() const { return fault_state; }
+		const Half_word& jump_register() const { return jump; }
+		const Word& accumulator() const { return accum; }
+		const Word& extension_register() const { return exten; }
+		const Half_word& index_register(int) const;
+		Memory::const_reference memory_cell(int) const;
+		const Block_stats& block_stats() const { return blocks.stats(); }
+		Jit_mode jit_mode() const { return jit_state; }
 
 		// Mutators.
+		void program_counter(int);
 		void overflow_bit(Bit);
 		void jump_register(const Half_word&);
 		void accumulator(const Word&);
 		void extension_register(const Word&);
 		void index_register(int, const Half_word&);
 		void memory_cell(int, const Word&);
+		void jit_mode(Jit_mode);
 
 
 	private:
@@ -82,20 +145,198 @@ namespace mix
 		Half_word jump;
 		Word accum;
 		Word exten;
-		std::vector<Half_word> index;
+		std::array<Half_word, num_index_registers> index;
 
 		// Memory.
-		std::vector<Word> memory;
+		Memory memory;
+
+		// Last loaded program, restored by reset.
+		Program_image program_image;
+
+		// Predecoded instructions, invalidated by writes to their cells.
+		Basic_decode_cache<mem_size> decoded;
+
+		// Translated blocks, invalidated by writes to their cells. Their
+		// pools are allocated as blocks are translated.
+		Basic_block_cache<mem_size> blocks;
 
 		// End of program flag.
 		bool program_finished;
 
+		// Last trapped fault.
+		Fault fault_state;
+
+		// JIT, and the machine replaying native runs in differential mode.
+		Jit_mode jit_state;
+		std::unique_ptr<Jit> jit;
+		std::unique_ptr<Machine> reference;
+
+		// Resetting.
+		void restore_memory(const Memory&);
+
+		// Decoding through the predecode cache.
+		const Predecoded& predecode(int);
+		void fill_decoded(int);
+		void fuse(int);
+		void indexed(const Predecoded&, Instruction&);
+		void apply_index(Instruction&);
+
+		// Running translated blocks.
+		void dispatch();
+		int lookup_block(int);
+		int translate(int);
+		int chain(int);
+		void run_blocks(int);
+		void execute(const Micro_op&, Instruction&);
+
+		// Running native code.
+		void run_jit(int);
+		Native_block native(int);
+		void run_differential(int, Native_block);
+		void copy_state(Machine&) const;
+		bool same_state(const Machine&) const;
+		Native_layout native_layout() const;
+
+		// Engine access validation.
+		bool in_memory(int);
+		bool in_index_registers(int);
+
 		// Validations.
 		void check_arguments(const std::vector<std::string>&) const;
-		void check_program_input_stream(std::istream*) const;
 		void check_index_register_number(int) const;
 		void check_memory_cell_address(int) const;
 	};
+
+
+	/*** Engine access. ***/
+
+	/*
+	* Returns whether the given address is in memory.
+	* If not, traps an address fault.
+	* Parameters:
+	*	address - Memory address.
+	*/
+	inline bool Machine::in_memory(int address)
+	{
+		if (static_cast<unsigned int>(address) < mem_size)
+			return true;
+		trap(Fault::Address, "Address out of bounds");
+		return false;
+	}
+
+	/*
+	* Returns whether the given index register number is in range [1, 6].
+	* If not, traps an index register fault.
+	* Parameters:
+	*	num - Index register number.
+	*/
+	inline bool Machine::in_index_registers(int num)
+	{
+		if (static_cast<unsigned int>(num - 1) < num_index_registers)
+			return true;
+		trap(Fault::Index_register, "Invalid index register number");
+		return false;
+	}
+
+	/*
+	* Returns the contents of memory at the given address.
+	* Out of range addresses read as +0.
+	* Parameters:
+	*	address - Memory address.
+	*/
+	inline Memory::const_reference Machine::fetch(int address)
+	{
+		static const Word zero{};
+		const Memory& cells{memory};
+		return in_memory(address) ? cells[address] : zero;
+	}
+
+	/*
+	* Write the given word to memory at the given address.
+	* Writes to out of range addresses are dropped.
+	* The predecoded instruction and translated blocks of the cell are
+	* invalidated, so self-modifying code sees its own writes.
+	* Parameters:
+	*	address - Memory address.
+	*	w - Word to write.
+	*/
+	inline void Machine::store(int address, const Word& w)
+	{
+		if (in_memory(address)) {
+			memory[address] = w;
+			decoded.invalidate(address);
+			blocks.invalidate(address);
+		}
+	}
+
+	/*
+	* Write the right-most bytes of the given word into a field of
+	* memory at the given address, in place.
+	* Writes to out of range addresses are dropped. The cell is
+	* invalidated as by store.
+	* Parameters:
+	*	address - Memory address.
+	*	w - Word to write.
+	*	field - Field of the cell to write.
+	*/
+	inline void Machine::store_field(int address,
+									 const Word& w,
+									 const Field_spec& field)
+	{
+		if (in_memory(address)) {
+			memory.insert_field(address, w, field);
+			decoded.invalidate(address);
+			blocks.invalidate(address);
+		}
+	}
+
+	/*
+	* Returns the contents of the given index register.
+	* Invalid registers read as +0.
+	* Parameters:
+	*	num - Index register number.
+	*/
+	inline const Half_word& Machine::fetch_index(int num)
+	{
+		static const Half_word zero{};
+		return in_index_registers(num) ? index[num - 1] : zero;
+	}
+
+	/*
+	* Load the given index register with the given half word.
+	* Loads of invalid registers are dropped.
+	* Parameters:
+	*	num - Index register number.
+	*	hw - Half word to load.
+	*/
+	inline void Machine::store_index(int num, const Half_word& hw)
+	{
+		if (in_index_registers(num))
+			index[num - 1] = hw;
+	}
+
+
+	/*** Register mutators. ***/
+
+	/*
+	* Load the accumulator with the given word.
+	* Parameters:
+	*	w - Word to load into accumulator.
+	*/
+	inline void Machine::accumulator(const Word& w)
+	{
+		accum = w;
+	}
+
+	/*
+	* Load the extension register with the given word.
+	* Parameters:
+	*	w - Word to load into extension register.
+	*/
+	inline void Machine::extension_register(const Word& w)
+	{
+		exten = w;
+	}
 }
 #endif
 
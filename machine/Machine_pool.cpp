@@ -0,0 +1,113 @@
+#include "Machine_pool.h"
+#include <utility>
+
+namespace mix
+{
+	/*
+	* Construct a pool of the given number of prepared machines.
+	* Parameters:
+	*	size - Number of machines to build up front.
+	*	mode - How returned machines are reset: Keep_program keeps the
+	*		program loaded by the preparation.
+	*	prepare - Preparation of each new machine.
+	*/
+	Machine_pool::Machine_pool(std::size_t size, Machine::Reset_mode mode,
+							   Preparation prepare)
+		: mode{mode}, prepare{std::move(prepare)}, lock{}, idle{}
+	{
+		idle.reserve(size);
+		for (std::size_t i = 0; i < size; ++i)
+			idle.push_back(make_machine());
+	}
+
+	/*
+	* Returns a lease on an idle machine, in its reset state.
+	* If no machine is idle, a new one is built and prepared.
+	*/
+	Machine_pool::Lease Machine_pool::acquire()
+	{
+		{
+			std::lock_guard<std::mutex> guard{lock};
+			if (!idle.empty()) {
+				std::unique_ptr<Machine> machine{std::move(idle.back())};
+				idle.pop_back();
+				return Lease{this, std::move(machine)};
+			}
+		}
+		return Lease{this, make_machine()};
+	}
+
+	/*
+	* Returns the number of idle machines.
+	*/
+	std::size_t Machine_pool::available() const
+	{
+		std::lock_guard<std::mutex> guard{lock};
+		return idle.size();
+	}
+
+	/*
+	* Returns a new prepared machine.
+	*/
+	std::unique_ptr<Machine> Machine_pool::make_machine() const
+	{
+		std::unique_ptr<Machine> machine{std::make_unique<Machine>()};
+		if (prepare)
+			prepare(*machine);
+		return machine;
+	}
+
+	/*
+	* Reset the given machine, and put it back with the idle machines.
+	* The reset runs outside the lock, so machines coming back at once
+	* are reset in parallel.
+	* Parameters:
+	*	machine - Machine to return.
+	*/
+	void Machine_pool::release(std::unique_ptr<Machine> machine)
+	{
+		machine->reset(mode);
+		std::lock_guard<std::mutex> guard{lock};
+		idle.push_back(std::move(machine));
+	}
+
+
+	/*** Lease. ***/
+
+	/*
+	* Construct a lease on the given machine.
+	* Parameters:
+	*	pool - Pool the machine goes back to.
+	*	machine - Leased machine.
+	*/
+	Machine_pool::Lease::Lease(Machine_pool* pool,
+							   std::unique_ptr<Machine> machine)
+		: pool{pool}, machine{std::move(machine)}
+	{
+	}
+
+	/*
+	* End the lease, handing the machine back to the pool.
+	*/
+	Machine_pool::Lease::~Lease()
+	{
+		if (machine)
+			pool->release(std::move(machine));
+	}
+
+	/*
+	* End this lease, and take over the given one.
+	* Parameters:
+	*	other - Lease to take over.
+	*/
+	Machine_pool::Lease& Machine_pool::Lease::operator=(Lease&& other)
+	{
+		if (this != &other) {
+			if (machine)
+				pool->release(std::move(machine));
+			pool = other.pool;
+			machine = std::move(other.machine);
+		}
+		return *this;
+	}
+}
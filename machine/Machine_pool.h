@@ -0,0 +1,86 @@
+#ifndef MIX_MACHINE_MACHINE_POOL_H
+#define MIX_MACHINE_MACHINE_POOL_H
+
+#include "Machine.h"
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace mix
+{
+	// Thread-safe pool of machines, for running many short programs.
+	// Machines are built and prepared once, then leased out and reset in
+	// place when they come back, so a job pays neither for constructing
+	// a machine nor for warming its caches. When every machine is leased,
+	// the pool grows by one.
+	class Machine_pool
+	{
+	public:
+		// Preparation of a new machine, such as loading a program or
+		// turning the JIT on.
+		using Preparation = std::function<void(Machine&)>;
+
+
+		// A machine leased from the pool, handed back when the lease ends.
+		class Lease
+		{
+		public:
+			// Constructors and destructor.
+			Lease(Machine_pool*, std::unique_ptr<Machine>);
+			Lease(const Lease&) = delete;
+			Lease(Lease&&) = default;
+			~Lease();
+
+
+			/* Operators. */
+
+			// Machine access.
+			Machine& operator*() const { return *machine; }
+			Machine* operator->() const { return machine.get(); }
+
+			// Assignment.
+			Lease& operator=(const Lease&) = delete;
+			Lease& operator=(Lease&&);
+
+
+		private:
+			// Pool the machine goes back to.
+			Machine_pool* pool;
+
+			// Leased machine.
+			std::unique_ptr<Machine> machine;
+		};
+
+
+		// Constructors.
+		Machine_pool(std::size_t, Machine::Reset_mode,
+					 Preparation prepare = {});
+		Machine_pool(const Machine_pool&) = delete;
+
+
+		/* Functions. */
+
+		// Leasing.
+		Lease acquire();
+		std::size_t available() const;
+
+
+	private:
+		// Reset mode of returned machines.
+		Machine::Reset_mode mode;
+
+		// Preparation of new machines.
+		Preparation prepare;
+
+		// Machines not leased, guarded by the lock.
+		mutable std::mutex lock;
+		std::vector<std::unique_ptr<Machine>> idle;
+
+		// Building and returning machines.
+		std::unique_ptr<Machine> make_machine() const;
+		void release(std::unique_ptr<Machine>);
+	};
+}
+#endif
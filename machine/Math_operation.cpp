@@ -1,4 +1,5 @@
 #include "Math_operation.h"
+#include "Arithmetic.h"
 #include <sstream>
 
 namespace mix
@@ -42,13 +43,14 @@ namespace mix
 			Machine* mix_machine,
 			const Instruction& inst) const
 	{
-		int accum{mix_machine->accumulator().to_int(inst.field)};
-		accum += mix_machine->memory_cell(inst.address).to_int(inst.field);
-		if (accum > Word::int_max()) {
-			accum -= Word::int_max();
+		const Word_result sum{add(
+			mix_machine->accumulator(),
+			mix_machine->memory_content(inst.address, inst.field)
+		)};
+		mix_machine->accumulator(sum.value);
+		if (sum.overflow) {
 			mix_machine->overflow_bit(Machine::Bit::On);
 		}
-		mix_machine->accumulator(accum);
 	}
 
 	/*
@@ -61,17 +63,19 @@ namespace mix
 			Machine* mix_machine,
 			const Instruction& inst) const
 	{
-		int accum{mix_machine->accumulator().to_int(inst.field)};
-		accum -= mix_machine->memory_cell(inst.address).to_int(inst.field);
-		if (accum < Word::int_min()) {
-			accum += Word::int_max();
+		const Word_result difference{subtract(
+			mix_machine->accumulator(),
+			mix_machine->memory_content(inst.address, inst.field)
+		)};
+		mix_machine->accumulator(difference.value);
+		if (difference.overflow) {
 			mix_machine->overflow_bit(Machine::Bit::On);
 		}
-		mix_machine->accumulator(accum);
 	}
 
 	/*
 	* Execute the given multiplication operation using the given machine.
+	* The 10-byte product is left in rA:rX.
 	* Parameters:
 	*	mix_machine - Mix machine used to execute the operation.
 	*	inst - Instruction to execute.
@@ -80,11 +84,18 @@ namespace mix
 			Machine* mix_machine,
 			const Instruction& inst) const
 	{
-
+		const Double_word_result product{multiply(
+			mix_machine->accumulator(),
+			mix_machine->memory_content(inst.address, inst.field)
+		)};
+		mix_machine->accumulator(product.high);
+		mix_machine->extension_register(product.low);
 	}
 
 	/*
 	* Execute the given division operation using the given machine.
+	* The 10-byte dividend is rA:rX. The quotient is left in rA,
+	* the remainder in rX. On overflow rA:rX are left unchanged.
 	* Parameters:
 	*	mix_machine - Mix machine used to execute the operation.
 	*	inst - Instruction to execute.
@@ -93,7 +104,16 @@ namespace mix
 			Machine* mix_machine,
 			const Instruction& inst) const
 	{
-
+		const Double_word_result quotient{divide(
+			mix_machine->accumulator(),
+			mix_machine->extension_register(),
+			mix_machine->memory_content(inst.address, inst.field)
+		)};
+		if (quotient.overflow) {
+			mix_machine->overflow_bit(Machine::Bit::On);
+			return;
+		}
+		mix_machine->accumulator(quotient.high);
+		mix_machine->extension_register(quotient.low);
 	}
 }
-
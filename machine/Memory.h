@@ -0,0 +1,248 @@
+#ifndef MIX_MACHINE_MEMORY_H
+#define MIX_MACHINE_MEMORY_H
+
+#include "Word.h"
+#include "Word_batch.h"
+#include <cstddef>
+
+namespace mix
+{
+	// Size of a cache line, in bytes.
+	const std::size_t CACHE_LINE_SIZE{64};
+
+	// Number of cells checked at once by whole-memory scans.
+	const int SCAN_BLOCK_SIZE{64};
+
+	// Number of characters of a word in a text memory image.
+	const int WORD_IMAGE_SIZE{Word::num_bytes + 1};
+
+
+	// A flat machine memory image, laid out as an array of words.
+	// All cells live in one contiguous, cache-line aligned block,
+	// so constructing a memory image never touches the heap.
+	template<unsigned int Num_cells>
+	class Basic_memory
+	{
+	public:
+		// Number of cells.
+		static const unsigned int num_cells = Num_cells;
+
+		// Cell references.
+		using reference = Word&;
+		using const_reference = const Word&;
+
+
+		// Constructor.
+		Basic_memory();
+
+
+		/* Operators. */
+
+		// Cell access, unchecked.
+		Word& operator[](int address) { return cells[address]; }
+		const Word& operator[](int address) const { return cells[address]; }
+
+
+		/* Functions. */
+
+		// Iteration over all cells, in address order.
+		Word* begin() { return cells; }
+		Word* end() { return cells + Num_cells; }
+		const Word* begin() const { return cells; }
+		const Word* end() const { return cells + Num_cells; }
+
+		// Raw image access.
+		Word* data() { return cells; }
+		const Word* data() const { return cells; }
+
+		// Field update in place, unchecked.
+		void insert_field(int, const Word&, const Field_spec&);
+
+		// Clear all cells to +0.
+		void clear();
+
+		// Whole-memory scans.
+		int first_invalid(int, int) const;
+		int first_difference(const Basic_memory&, int from = 0) const;
+		void write_image(char*) const;
+
+		// Whole-memory integer conversion.
+		void to_ints(long long*) const;
+		void from_ints(const long long*);
+
+		// Whole-memory packed conversion, for binary images.
+		void to_packed(Word::Packed*) const;
+		void from_packed(const Word::Packed*);
+
+
+	private:
+		// Implementation.
+		alignas(CACHE_LINE_SIZE) Word cells[Num_cells];
+	};
+
+
+	/*
+	* Construct a memory image with all cells cleared to +0.
+	* Template parameters:
+	*	N - Number of cells.
+	*/
+	template<unsigned int N>
+	Basic_memory<N>::Basic_memory()
+		: cells{}
+	{
+	}
+
+	/*
+	* Clear all cells to +0.
+	* Template parameters:
+	*	N - Number of cells.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::clear()
+	{
+		for (Word* p = begin(); p != end(); ++p)
+			p->clear();
+	}
+
+	/*
+	* Write the right-most bytes of the given word into a field of the
+	* cell at the given address, in place.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	w - Word to write.
+	*	field - Field of the cell to write.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::insert_field(int address,
+									   const Word& w,
+									   const Field_spec& field)
+	{
+		cells[address].insert_field(w, field);
+	}
+
+	/*
+	* Returns the address of the first invalid word in [first, last),
+	* or last if all words in the range are valid.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	first - First address to check.
+	*	last - One past the last address to check.
+	*/
+	template<unsigned int N>
+	int Basic_memory<N>::first_invalid(int first, int last) const
+	{
+		const Word* invalid{find_invalid(cells + first, cells + last)};
+		return static_cast<int>(invalid - cells);
+	}
+
+	/*
+	* Returns the first address, starting at from, whose cell differs
+	* from the same cell of the given memory, or N if there is none.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	other - Memory to compare to.
+	*	from - First address to compare.
+	*/
+	template<unsigned int N>
+	int Basic_memory<N>::first_difference(const Basic_memory& other,
+										  int from) const
+	{
+		const int size{static_cast<int>(N)};
+		for (int block = from; block < size; block += SCAN_BLOCK_SIZE) {
+			const int last{block + SCAN_BLOCK_SIZE < size ?
+						   block + SCAN_BLOCK_SIZE : size};
+
+			// Branch-free check of a whole block, then find the cell.
+			bool differs{false};
+			for (int i = block; i < last; ++i)
+				differs |= cells[i].packed() != other.cells[i].packed();
+			if (!differs)
+				continue;
+			for (int i = block; i < last; ++i) {
+				if (!(cells[i] == other.cells[i]))
+					return i;
+			}
+		}
+		return size;
+	}
+
+	/*
+	* Write the text image of all cells, in address order, into the given
+	* buffer of N * WORD_IMAGE_SIZE characters. Each word is written as
+	* its sign followed by its bytes, as by operator<<.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer to write into.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::write_image(char* out) const
+	{
+		for (const Word& w : cells) {
+			*out++ = static_cast<char>(w.sign());
+			for (int i = 1; i <= Word::num_bytes; ++i)
+				*out++ = static_cast<char>(w.byte(i));
+		}
+	}
+
+	/*
+	* Convert all cells, in address order, to integers.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer of N integers.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::to_ints(long long* out) const
+	{
+		mix::to_ints(begin(), end(), out);
+	}
+
+	/*
+	* Set all cells, in address order, from integers.
+	* If an integer doesn't fit in a word, throws an exception
+	* before any cell is written.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	values - Buffer of N integers.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::from_ints(const long long* values)
+	{
+		mix::from_ints(values, values + N, begin());
+	}
+
+	/*
+	* Copy the packed representation of all cells, in address order.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer of N packed words.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::to_packed(Word::Packed* out) const
+	{
+		for (const Word& w : cells)
+			*out++ = w.packed();
+	}
+
+	/*
+	* Set all cells, in address order, from their packed representation.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	values - Buffer of N packed words.
+	*/
+	template<unsigned int N>
+	void Basic_memory<N>::from_packed(const Word::Packed* values)
+	{
+		for (Word& w : cells)
+			w = Word::from_packed(*values++);
+	}
+}
+#endif
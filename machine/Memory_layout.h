@@ -0,0 +1,25 @@
+#ifndef MIX_MACHINE_MEMORY_LAYOUT_H
+#define MIX_MACHINE_MEMORY_LAYOUT_H
+
+#include "Memory.h"
+#ifdef MIX_SPLIT_MEMORY
+#include "Split_memory.h"
+#endif
+#ifdef MIX_PAGED_MEMORY
+#include "Paged_memory.h"
+#endif
+
+namespace mix
+{
+	// Machine memory layout, selected at build time.
+	// "make split_memory=1" keeps magnitudes and signs in separate arrays.
+	// "make paged_memory=1" shares pages copy-on-write between machines.
+#if defined(MIX_SPLIT_MEMORY)
+	using Memory = Basic_split_memory<4000>;
+#elif defined(MIX_PAGED_MEMORY)
+	using Memory = Basic_paged_memory<4000>;
+#else
+	using Memory = Basic_memory<4000>;
+#endif
+}
+#endif
@@ -9,7 +9,17 @@ namespace mix
 	*/
 	bool is_math_op(Op_code code)
 	{
-		return (Op_code::ADD <= code && code <= Op_code::DIV);
+		return op_kind(code) == Op_kind::Math;
+	}
+
+	/*
+	* Returns whether or not the given op code is a shift operation.
+	* Parameters:
+	*	code - Operation code.
+	*/
+	bool is_shift_op(Op_code code)
+	{
+		return op_kind(code) == Op_kind::Shift;
 	}
 
 	/*
@@ -20,7 +30,7 @@ namespace mix
 	*/
 	bool is_load_op(Op_code code)
 	{
-		return (Op_code::LDA <= code && code <= Op_code::LDX);
+		return op_kind(code) == Op_kind::Load;
 	}
 
 	/*
@@ -31,7 +41,7 @@ namespace mix
 	*/
 	bool is_load_neg_op(Op_code code)
 	{
-		return (Op_code::LDAN <= code && code <= Op_code::LDXN);
+		return op_kind(code) == Op_kind::Load_neg;
 	}
 
 	/*
@@ -41,7 +51,6 @@ namespace mix
 	*/
 	bool is_store_op(Op_code code)
 	{
-		return (Op_code::STA <= code && code <= Op_code::STZ);
+		return op_kind(code) == Op_kind::Store;
 	}
 }
-
@@ -10,6 +10,9 @@ namespace mix
 		// Arithmetic operations.
 		ADD = 1, SUB, MUL, DIV,
 
+		// Shift operations, selected by the field.
+		SFT = 6,
+
 		// Load operations.
 		LDA = 8,
 		LD1, LD2, LD3, LD4, LD5, LD6,
@@ -28,7 +31,39 @@ namespace mix
 		STZ
 	};
 
+	// Kinds of instruction, one per operation type.
+	// Specialized and Fused mark predecoded instructions with a handler
+	// of their own, or starting a superinstruction; no op code is of
+	// those kinds.
+	enum Op_kind : Byte
+	{
+		Unknown, Math, Shift, Load, Load_neg, Store, Specialized, Fused
+	};
+
+	/*
+	* Returns the kind of operation of the given op code.
+	* Op codes without an operation, such as invalid bytes, are unknown.
+	* The dispatch and decoding tables are built from this mapping.
+	* Parameters:
+	*	code - Operation code.
+	*/
+	constexpr Op_kind op_kind(Op_code code)
+	{
+		if (Op_code::ADD <= code && code <= Op_code::DIV)
+			return Op_kind::Math;
+		if (code == Op_code::SFT)
+			return Op_kind::Shift;
+		if (Op_code::LDA <= code && code <= Op_code::LDX)
+			return Op_kind::Load;
+		if (Op_code::LDAN <= code && code <= Op_code::LDXN)
+			return Op_kind::Load_neg;
+		if (Op_code::STA <= code && code <= Op_code::STZ)
+			return Op_kind::Store;
+		return Op_kind::Unknown;
+	}
+
 	bool is_math_op(Op_code);
+	bool is_shift_op(Op_code);
 	bool is_load_op(Op_code);
 	bool is_load_neg_op(Op_code);
 	bool is_store_op(Op_code);
@@ -0,0 +1,270 @@
+#include "Op_specializations.h"
+#include "Machine.h"
+#include <array>
+
+namespace mix
+{
+	namespace Op_specializations
+	{
+		namespace
+		{
+			// Op codes with specializations, from LDA to STZ.
+			constexpr int NUM_CODES{Op_code::STZ - Op_code::LDA + 1};
+
+			// Encoded fields with specializations, up to (5:5).
+			constexpr int NUM_FIELDS{
+				Field_spec{Word::num_bytes, Word::num_bytes}.encode() + 1
+			};
+
+			// Ids of specialized handlers, indexed by op code from LDA,
+			// encoded field and whether the instruction is indexed.
+			using Table = std::array<
+				std::array<std::array<Byte, 2>, NUM_FIELDS>,
+				NUM_CODES
+			>;
+
+			// Specialized handlers, indexed by id.
+			using Handlers = std::array<Specialized_handler, NUM_HANDLERS>;
+
+			static_assert(NUM_HANDLERS <= 256, "Handler ids fit in a byte");
+
+			/*
+			* Returns the address of the given instruction,
+			* offset by its index register if it has one.
+			* Template parameters:
+			*	Indexed - Whether the instruction specifies an index.
+			* Parameters:
+			*	mix_machine - Mix machine executing the instruction.
+			*	entry - Predecoded instruction.
+			*/
+			template<bool Indexed>
+			int effective_address(Machine* mix_machine,
+								  const Predecoded& entry)
+			{
+				if constexpr (Indexed) {
+					const int offset{
+						get_address(mix_machine->fetch_index(entry.index_spec))
+					};
+					return entry.address + offset;
+				}
+				else {
+					return entry.address;
+				}
+			}
+
+			/*
+			* Load the register of the given load op code.
+			* Template parameters:
+			*	Code - Load op code.
+			* Parameters:
+			*	mix_machine - Mix machine to load.
+			*	w - Word to load.
+			*/
+			template<Op_code Code>
+			void load_register(Machine* mix_machine, const Word& w)
+			{
+				if constexpr (Code == Op_code::LDA)
+					mix_machine->accumulator(w);
+				else if constexpr (Code == Op_code::LDX)
+					mix_machine->extension_register(w);
+				else
+					mix_machine->store_index(Code - Op_code::LD1 + 1, w);
+			}
+
+			/*
+			* Returns the register of the given store op code.
+			* Template parameters:
+			*	Code - Store op code.
+			* Parameters:
+			*	mix_machine - Mix machine to read.
+			*/
+			template<Op_code Code>
+			Word stored_register(Machine* mix_machine)
+			{
+				if constexpr (Code == Op_code::STA)
+					return mix_machine->accumulator();
+				else if constexpr (Code == Op_code::STX)
+					return mix_machine->extension_register();
+				else if constexpr (Code == Op_code::STJ)
+					return mix_machine->jump_register();
+				else if constexpr (Code == Op_code::STZ)
+					return Word{};
+				else
+					return mix_machine->fetch_index(Code - Op_code::ST1 + 1);
+			}
+
+			/*
+			* Execute a load of the field (L:R).
+			* Template parameters:
+			*	Code - Load op code.
+			*	L - Left of the field.
+			*	R - Right of the field.
+			*	Indexed - Whether the instruction specifies an index.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instruction.
+			*	entry - Predecoded instruction.
+			*/
+			template<Op_code Code, int L, int R, bool Indexed>
+			void execute_load(Machine* mix_machine, const Predecoded& entry)
+			{
+				constexpr Field_spec field{L, R};
+				const int address{
+					effective_address<Indexed>(mix_machine, entry)
+				};
+				const Word cell{mix_machine->fetch(address)};
+				load_register<Code>(mix_machine,
+									cell.field_aligned_right(field));
+			}
+
+			/*
+			* Execute a store into the field (L:R), in place.
+			* A store of the whole word doesn't read the cell first.
+			* Template parameters:
+			*	Code - Store op code.
+			*	L - Left of the field.
+			*	R - Right of the field.
+			*	Indexed - Whether the instruction specifies an index.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instruction.
+			*	entry - Predecoded instruction.
+			*/
+			template<Op_code Code, int L, int R, bool Indexed>
+			void execute_store(Machine* mix_machine, const Predecoded& entry)
+			{
+				constexpr Field_spec field{L, R};
+				const int address{
+					effective_address<Indexed>(mix_machine, entry)
+				};
+				const Word reg{stored_register<Code>(mix_machine)};
+				if constexpr (L == 0 && R == Word::num_bytes)
+					mix_machine->store(address, reg);
+				else
+					mix_machine->store_field(address, reg, field);
+			}
+
+			/*
+			* Trap an instruction that doesn't decode: a field fault if
+			* its field is invalid, else a word fault.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instruction.
+			*	entry - Predecoded instruction.
+			*/
+			void execute_invalid(Machine* mix_machine, const Predecoded& entry)
+			{
+				if (!Decoder::field_table[entry.field].valid) {
+					mix_machine->trap(Machine::Fault::Field,
+									  "Invalid field specification");
+				}
+				else {
+					mix_machine->trap(Machine::Fault::Word,
+									  "Invalid instruction word");
+				}
+			}
+
+			/*
+			* Add the handlers of the given op code and field (L:R),
+			* giving them the next ids.
+			* Template parameters:
+			*	Code - Load or store op code.
+			*	L - Left of the field.
+			*	R - Right of the field.
+			* Parameters:
+			*	table - Table of ids to fill.
+			*	handlers - Handlers to fill.
+			*	next - Next free id.
+			*/
+			template<Op_code Code, int L, int R>
+			constexpr void add(Table& table, Handlers& handlers, int& next)
+			{
+				constexpr int field{Field_spec{L, R}.encode()};
+				auto& entry = table[Code - Op_code::LDA][field];
+				entry[false] = static_cast<Byte>(next);
+				entry[true] = static_cast<Byte>(next + 1);
+				if constexpr (Code <= Op_code::LDX) {
+					handlers[next] = execute_load<Code, L, R, false>;
+					handlers[next + 1] = execute_load<Code, L, R, true>;
+				}
+				else {
+					handlers[next] = execute_store<Code, L, R, false>;
+					handlers[next + 1] = execute_store<Code, L, R, true>;
+				}
+				next += 2;
+			}
+
+			/*
+			* Add the handlers of the common fields of the given op codes:
+			* the whole word (0:5), the magnitude (1:5), the signed address
+			* (0:2), and the right-most bytes (4:5) and (5:5).
+			* Template parameters:
+			*	Codes - Load or store op codes.
+			* Parameters:
+			*	table - Table of ids to fill.
+			*	handlers - Handlers to fill.
+			*	next - Next free id.
+			*/
+			template<Op_code... Codes>
+			constexpr void add_common_fields(Table& table,
+											 Handlers& handlers,
+											 int& next)
+			{
+				(add<Codes, 0, 5>(table, handlers, next), ...);
+				(add<Codes, 1, 5>(table, handlers, next), ...);
+				(add<Codes, 0, 2>(table, handlers, next), ...);
+				(add<Codes, 4, 5>(table, handlers, next), ...);
+				(add<Codes, 5, 5>(table, handlers, next), ...);
+			}
+
+			// Ids, and the handlers they refer to.
+			struct Tables
+			{
+				Table table;
+				Handlers handlers;
+			};
+
+			/*
+			* Build the tables of specialized handlers, after the
+			* handler of instructions that don't decode.
+			* Load negatives, and other fields, have none.
+			*/
+			constexpr Tables make_tables()
+			{
+				Tables tables{};
+				tables.handlers[INVALID_HANDLER] = execute_invalid;
+				int next{INVALID_HANDLER + 1};
+				add_common_fields<
+					Op_code::LDA, Op_code::LD1, Op_code::LD2, Op_code::LD3,
+					Op_code::LD4, Op_code::LD5, Op_code::LD6, Op_code::LDX
+				>(tables.table, tables.handlers, next);
+				add_common_fields<
+					Op_code::STA, Op_code::ST1, Op_code::ST2, Op_code::ST3,
+					Op_code::ST4, Op_code::ST5, Op_code::ST6, Op_code::STX,
+					Op_code::STJ, Op_code::STZ
+				>(tables.table, tables.handlers, next);
+				return tables;
+			}
+
+			// Specialized handlers.
+			constexpr Tables tables{make_tables()};
+		}
+
+		// Specialized handlers, indexed by id.
+		const std::array<Specialized_handler, NUM_HANDLERS> handlers{
+			tables.handlers
+		};
+
+		/*
+		* Returns the id of the handler specialized for the given
+		* instruction, or NO_HANDLER if it has none.
+		* Parameters:
+		*	inst - Instruction, with an unindexed address.
+		*/
+		Byte find(const Instruction& inst)
+		{
+			const int code{inst.op_code - Op_code::LDA};
+			const int field{inst.field.encode()};
+			if (code < 0 || NUM_CODES <= code || NUM_FIELDS <= field)
+				return NO_HANDLER;
+			return tables.table[code][field][inst.index_spec != 0];
+		}
+	}
+}
@@ -0,0 +1,53 @@
+#ifndef MIX_MACHINE_OP_SPECIALIZATIONS_H
+#define MIX_MACHINE_OP_SPECIALIZATIONS_H
+
+#include "Decode_cache.h"
+#include "Instruction.h"
+#include "Op_code.h"
+#include <array>
+
+namespace mix
+{
+	// Handlers specialized on the op code, field and indexing of an
+	// instruction, for the common forms of loads and stores, and the
+	// handler trapping instructions that don't decode.
+	// The generic operations switch on the op code and look the field
+	// masks up at run time; a specialized handler has them compiled in,
+	// and skips the index register when the instruction has none.
+	namespace Op_specializations
+	{
+		// Fields with specializations, per op code.
+		constexpr int NUM_COMMON_FIELDS{5};
+
+		// Id of the handler of instructions that don't decode, with an
+		// invalid field, sign or byte. It traps a field or word fault.
+		constexpr Byte INVALID_HANDLER{NO_HANDLER + 1};
+
+		// Number of handler ids: NO_HANDLER, INVALID_HANDLER, then the
+		// unindexed and indexed handlers of the common fields of loads
+		// and stores.
+		constexpr int NUM_HANDLERS{
+			2 + ((Op_code::LDX - Op_code::LDA + 1)
+				 + (Op_code::STZ - Op_code::STA + 1))
+				* NUM_COMMON_FIELDS * 2
+		};
+
+		// Specialized handlers, indexed by id.
+		extern const std::array<Specialized_handler, NUM_HANDLERS> handlers;
+
+		// Returns the id of the handler specialized for the given
+		// instruction, or NO_HANDLER if it has none.
+		Byte find(const Instruction&);
+
+		/*
+		* Returns the specialized handler with the given id.
+		* Parameters:
+		*	id - Id of a specialized handler.
+		*/
+		inline Specialized_handler handler(Byte id)
+		{
+			return handlers[id];
+		}
+	}
+}
+#endif
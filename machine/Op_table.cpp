@@ -0,0 +1,81 @@
+#include "Op_table.h"
+#include "Operations.h"
+#include <sstream>
+
+namespace mix
+{
+	namespace Op_table
+	{
+		namespace
+		{
+			/*
+			* Execute the given instruction with an operation of type Op.
+			* Operations hold no state, so a temporary is enough,
+			* and its exact type lets the call bind statically.
+			* Template parameters:
+			*	Op - Operation type.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instruction.
+			*	inst - Instruction to execute.
+			*/
+			template<typename Op>
+			void execute(Machine* mix_machine, const Instruction& inst)
+			{
+				Op{}.execute(mix_machine, inst);
+			}
+
+			/*
+			* Returns the handler of the given kind of operation.
+			* Unknown operations get the fault entry.
+			* Parameters:
+			*	kind - Kind of operation of an op code.
+			*/
+			constexpr Handler kind_handler(Op_kind kind)
+			{
+				switch (kind)
+				{
+				case Op_kind::Math:
+					return execute<Math_operation>;
+				case Op_kind::Shift:
+					return execute<Shift_operation>;
+				case Op_kind::Load:
+					return execute<Load_operation>;
+				case Op_kind::Load_neg:
+					return execute<Load_neg_operation>;
+				case Op_kind::Store:
+					return execute<Store_operation>;
+				default:
+					return execute_unknown;
+				}
+			}
+
+			/*
+			* Build the dispatch table, from the kind of each op code.
+			*/
+			constexpr std::array<Handler, NUM_OP_CODES> make_handlers()
+			{
+				std::array<Handler, NUM_OP_CODES> table{};
+				for (int code = 0; code < NUM_OP_CODES; ++code)
+					table[code] = kind_handler(
+						op_kind(static_cast<Op_code>(code)));
+				return table;
+			}
+		}
+
+		// Handlers, indexed by op code.
+		const std::array<Handler, NUM_OP_CODES> handlers{make_handlers()};
+
+		/*
+		* Fault entry: trap an unknown op code.
+		* Parameters:
+		*	mix_machine - Mix machine used to execute the instruction.
+		*	inst - Instruction to execute.
+		*/
+		void execute_unknown(Machine* mix_machine, const Instruction& inst)
+		{
+			std::stringstream message{};
+			message << "Unknown op code: " << static_cast<int>(inst.op_code);
+			mix_machine->trap(Machine::Fault::Op_code, message.str().c_str());
+		}
+	}
+}
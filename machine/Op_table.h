@@ -0,0 +1,40 @@
+#ifndef MIX_MACHINE_OP_TABLE_H
+#define MIX_MACHINE_OP_TABLE_H
+
+#include "Instruction.h"
+#include "Machine.h"
+#include "Op_code.h"
+#include "Word.h"
+#include <array>
+
+namespace mix
+{
+	// Number of op codes, one per byte value.
+	constexpr int NUM_OP_CODES{Word::byte_model::radix};
+
+	// Static op code dispatch table.
+	// Handlers are stateless, so dispatching never allocates.
+	// Op codes without an operation trap through the fault entry.
+	namespace Op_table
+	{
+		// Handlers, indexed by op code.
+		extern const std::array<Handler, NUM_OP_CODES> handlers;
+
+		// Handler of op codes without an operation.
+		void execute_unknown(Machine*, const Instruction&);
+
+		/*
+		* Returns the handler of the given op code.
+		* Bytes outside the table, such as invalid bytes, get the fault entry.
+		* Parameters:
+		*	code - Operation code.
+		*/
+		inline Handler handler(Op_code code)
+		{
+			if (code < NUM_OP_CODES)
+				return handlers[code];
+			return execute_unknown;
+		}
+	}
+}
+#endif
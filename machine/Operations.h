@@ -3,6 +3,7 @@
 
 #include "Operation.h"
 #include "Math_operation.h"
+#include "Shift_operation.h"
 #include "Load_operation.h"
 #include "Load_neg_operation.h"
 #include "Store_operation.h"
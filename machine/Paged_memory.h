@@ -0,0 +1,367 @@
+#ifndef MIX_MACHINE_PAGED_MEMORY_H
+#define MIX_MACHINE_PAGED_MEMORY_H
+
+#include "Memory.h"
+#include "Word.h"
+#include "Word_batch.h"
+#include <array>
+#include <memory>
+
+namespace mix
+{
+	// A machine memory image split into fixed-size pages, shared
+	// copy-on-write. Copying a paged memory copies page pointers only,
+	// and a page is copied the first time either memory writes to it,
+	// so cloned machines pay for the pages they touch. Cleared pages
+	// all share one blank page. Reads never copy: writes go through the
+	// non-const cell access, reads through the const one.
+	template<unsigned int Num_cells, unsigned int Page_size = 64>
+	class Basic_paged_memory
+	{
+	public:
+		// Number of cells.
+		static const unsigned int num_cells = Num_cells;
+
+		// Number of cells of a page, and number of pages.
+		static const unsigned int page_size = Page_size;
+		static const unsigned int num_pages =
+			(Num_cells + Page_size - 1) / Page_size;
+
+		// Cell references.
+		using reference = Word&;
+		using const_reference = const Word&;
+
+
+		// Constructor.
+		Basic_paged_memory();
+
+
+		/* Operators. */
+
+		// Cell access, unchecked. Writable access copies a shared page.
+		Word& operator[](int address)
+		{
+			return own(address / Page_size).cells[address % Page_size];
+		}
+		const Word& operator[](int address) const
+		{
+			return pages[address / Page_size]->cells[address % Page_size];
+		}
+
+
+		/* Functions. */
+
+		// Field update in place, unchecked.
+		void insert_field(int, const Word&, const Field_spec&);
+
+		// Clear all cells to +0.
+		void clear();
+
+		// Page sharing.
+		bool shares_page(const Basic_paged_memory&, int) const;
+
+		// Whole-memory scans.
+		int first_invalid(int, int) const;
+		int first_difference(const Basic_paged_memory&, int from = 0) const;
+		void write_image(char*) const;
+
+		// Whole-memory integer conversion.
+		void to_ints(long long*) const;
+		void from_ints(const long long*);
+
+		// Whole-memory packed conversion, for binary images.
+		void to_packed(Word::Packed*) const;
+		void from_packed(const Word::Packed*);
+
+
+	private:
+		// A page of cells.
+		struct Page
+		{
+			alignas(CACHE_LINE_SIZE) Word cells[Page_size];
+		};
+
+		// Implementation.
+		std::array<std::shared_ptr<Page>, num_pages> pages;
+
+		// Helper functions.
+		Page& own(int);
+		static int page_end(int);
+		static const std::shared_ptr<Page>& blank_page();
+	};
+
+
+	/*
+	* Construct a memory image with all cells cleared to +0.
+	* No page is allocated until it is written.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	*/
+	template<unsigned int N, unsigned int P>
+	Basic_paged_memory<N, P>::Basic_paged_memory()
+		: pages{}
+	{
+		clear();
+	}
+
+	/*
+	* Returns the page all cleared pages share.
+	* It is never written, since it always has more than one owner.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	*/
+	template<unsigned int N, unsigned int P>
+	const std::shared_ptr<typename Basic_paged_memory<N, P>::Page>&
+		Basic_paged_memory<N, P>::blank_page()
+	{
+		static const std::shared_ptr<Page> blank{std::make_shared<Page>()};
+		return blank;
+	}
+
+	/*
+	* Returns the given page, copied first if another memory shares it.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	page - Page number, in range [0, num_pages).
+	*/
+	template<unsigned int N, unsigned int P>
+	typename Basic_paged_memory<N, P>::Page&
+		Basic_paged_memory<N, P>::own(int page)
+	{
+		std::shared_ptr<Page>& p{pages[page]};
+		if (p.use_count() != 1)
+			p = std::make_shared<Page>(*p);
+		return *p;
+	}
+
+	/*
+	* Returns one past the last cell of the given page.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	page - Page number, in range [0, num_pages).
+	*/
+	template<unsigned int N, unsigned int P>
+	int Basic_paged_memory<N, P>::page_end(int page)
+	{
+		const int end{(page + 1) * static_cast<int>(P)};
+		return end < static_cast<int>(N) ? end : static_cast<int>(N);
+	}
+
+	/*
+	* Clear all cells to +0, sharing the blank page.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::clear()
+	{
+		pages.fill(blank_page());
+	}
+
+	/*
+	* Write the right-most bytes of the given word into a field of the
+	* cell at the given address, in place.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	w - Word to write.
+	*	field - Field of the cell to write.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::insert_field(int address,
+												const Word& w,
+												const Field_spec& field)
+	{
+		(*this)[address].insert_field(w, field);
+	}
+
+	/*
+	* Returns whether the cell at the given address lives in the same
+	* page as in the given memory.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	other - Memory to compare to.
+	*	address - Memory address, in range [0, N).
+	*/
+	template<unsigned int N, unsigned int P>
+	bool Basic_paged_memory<N, P>::shares_page(const Basic_paged_memory& other,
+											   int address) const
+	{
+		return pages[address / P] == other.pages[address / P];
+	}
+
+	/*
+	* Returns the address of the first invalid word in [first, last),
+	* or last if all words in the range are valid.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	first - First address to check.
+	*	last - One past the last address to check.
+	*/
+	template<unsigned int N, unsigned int P>
+	int Basic_paged_memory<N, P>::first_invalid(int first, int last) const
+	{
+		while (first < last) {
+			const int page{first / static_cast<int>(P)};
+			const int base{page * static_cast<int>(P)};
+			const int end{page_end(page) < last ? page_end(page) : last};
+			const Word* cells{pages[page]->cells};
+			const Word* invalid{
+				find_invalid(cells + first - base, cells + end - base)
+			};
+			if (invalid != cells + end - base)
+				return base + static_cast<int>(invalid - cells);
+			first = end;
+		}
+		return last;
+	}
+
+	/*
+	* Returns the first address, starting at from, whose cell differs
+	* from the same cell of the given memory, or N if there is none.
+	* Pages both memories share are skipped without being read.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	other - Memory to compare to.
+	*	from - First address to compare.
+	*/
+	template<unsigned int N, unsigned int P>
+	int Basic_paged_memory<N, P>::first_difference
+			(const Basic_paged_memory& other, int from) const
+	{
+		for (int page = from / static_cast<int>(P);
+				page < static_cast<int>(num_pages); ++page) {
+			if (pages[page] == other.pages[page])
+				continue;
+			const int base{page * static_cast<int>(P)};
+			const int end{page_end(page)};
+			for (int i = (base < from ? from : base); i < end; ++i) {
+				if (!(pages[page]->cells[i - base]
+						== other.pages[page]->cells[i - base]))
+					return i;
+			}
+		}
+		return static_cast<int>(N);
+	}
+
+	/*
+	* Write the text image of all cells, in address order, into the given
+	* buffer of N * WORD_IMAGE_SIZE characters. Each word is written as
+	* its sign followed by its bytes, as by operator<<.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	out - Buffer to write into.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::write_image(char* out) const
+	{
+		for (int address = 0; address < static_cast<int>(N); ++address) {
+			const Word& w{(*this)[address]};
+			*out++ = static_cast<char>(w.sign());
+			for (int i = 1; i <= Word::num_bytes; ++i)
+				*out++ = static_cast<char>(w.byte(i));
+		}
+	}
+
+	/*
+	* Convert all cells, in address order, to integers.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	out - Buffer of N integers.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::to_ints(long long* out) const
+	{
+		for (int page = 0; page < static_cast<int>(num_pages); ++page) {
+			const int base{page * static_cast<int>(P)};
+			const Word* cells{pages[page]->cells};
+			mix::to_ints(cells, cells + page_end(page) - base, out + base);
+		}
+	}
+
+	/*
+	* Set all cells, in address order, from integers.
+	* If an integer doesn't fit in a word, throws an exception
+	* before any cell is written.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	values - Buffer of N integers.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::from_ints(const long long* values)
+	{
+		check_ints(values, values + N);
+		for (int page = 0; page < static_cast<int>(num_pages); ++page) {
+			const int base{page * static_cast<int>(P)};
+			Word* cells{own(page).cells};
+			mix::from_ints(values + base, values + page_end(page),
+						   cells);
+		}
+	}
+
+	/*
+	* Copy the packed representation of all cells, in address order.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	out - Buffer of N packed words.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::to_packed(Word::Packed* out) const
+	{
+		for (int address = 0; address < static_cast<int>(N); ++address)
+			out[address] = (*this)[address].packed();
+	}
+
+	/*
+	* Set all cells, in address order, from their packed representation.
+	* Pages that come out blank share the blank page again.
+	* Template parameters:
+	*	N - Number of cells.
+	*	P - Number of cells of a page.
+	* Parameters:
+	*	values - Buffer of N packed words.
+	*/
+	template<unsigned int N, unsigned int P>
+	void Basic_paged_memory<N, P>::from_packed(const Word::Packed* values)
+	{
+		const Word::Packed blank{Word{}.packed()};
+		for (int page = 0; page < static_cast<int>(num_pages); ++page) {
+			const int base{page * static_cast<int>(P)};
+			const int end{page_end(page)};
+			bool is_blank{true};
+			for (int i = base; i < end; ++i)
+				is_blank &= values[i] == blank;
+			if (is_blank) {
+				pages[page] = blank_page();
+				continue;
+			}
+			Page& p{own(page)};
+			for (int i = base; i < end; ++i)
+				p.cells[i - base] = Word::from_packed(values[i]);
+		}
+	}
+}
+#endif
@@ -0,0 +1,62 @@
+#include "Program_image.h"
+#include <stdexcept>
+
+namespace mix
+{
+	/*
+	* Construct an empty program image, with all cells cleared to +0.
+	* Empty images all share the same cells.
+	*/
+	Program_image::Program_image()
+		: cells{}, num_cells{0}
+	{
+		static const std::shared_ptr<const Memory> blank{
+			std::make_shared<const Memory>()
+		};
+		cells = blank;
+	}
+
+	/*
+	* Construct a program image from the words read from the given
+	* stream, placed from address 0. Words are read straight into their
+	* cells, then the whole image is validated in a single scan.
+	* If the program can't be read, doesn't fit in memory or holds an
+	* invalid word, throws an exception.
+	* Parameters:
+	*	program - Stream to read the program from.
+	*/
+	Program_image::Program_image(std::istream* program)
+		: cells{}, num_cells{0}
+	{
+		check_program_input_stream(program);
+		const std::shared_ptr<Memory> image{std::make_shared<Memory>()};
+		Word word{};
+		while (*program >> word) {
+			if (static_cast<int>(Memory::num_cells) <= num_cells) {
+				throw std::invalid_argument{"Program does not fit in memory"};
+			}
+			(*image)[num_cells++] = word;
+		}
+		if (image->first_invalid(0, num_cells) != num_cells) {
+			throw Invalid_basic_word{};
+		}
+		cells = image;
+	}
+
+	/*
+	* Check the program stream.
+	* If the stream cannot be read, throws an exception.
+	* If the stream is empty, throws an exception.
+	* Parameters:
+	*	program - Stream to read the program from.
+	*/
+	void Program_image::check_program_input_stream(std::istream* program)
+	{
+		if (program->fail()) {
+			throw std::invalid_argument{"Cannot read program"};
+		}
+		if (program->peek() == EOF) {
+			throw std::invalid_argument{"Program file is empty"};
+		}
+	}
+}
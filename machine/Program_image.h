@@ -0,0 +1,55 @@
+#ifndef MIX_MACHINE_PROGRAM_IMAGE_H
+#define MIX_MACHINE_PROGRAM_IMAGE_H
+
+#include "Memory_layout.h"
+#include "Word.h"
+#include <iostream>
+#include <memory>
+
+namespace mix
+{
+	// An immutable program image, read and validated once, that any
+	// number of machines load as the base of their memory. Images are
+	// reference counted: copies share the same cells, which live as long
+	// as any machine or copy still refers to them. With paged memory, a
+	// machine loading an image shares its pages too, and owns a private
+	// copy only of the pages it writes to. Its memory then grows with the
+	// pages it writes instead of with its memory size. Each machine still
+	// keeps its own decode cache, one entry per cell, about 36 KB.
+	// Translated blocks grow with the code the machine runs.
+	class Program_image
+	{
+	public:
+		// Constructors.
+		Program_image();
+		explicit Program_image(std::istream*);
+
+
+		/* Operators. */
+
+		// Cell access, unchecked.
+		Memory::const_reference operator[](int address) const
+		{
+			return (*cells)[address];
+		}
+
+
+		/* Functions. */
+
+		// Number of cells the program takes, from address 0.
+		int size() const { return num_cells; }
+
+		// All cells, with those after the program cleared to +0.
+		const Memory& memory() const { return *cells; }
+
+
+	private:
+		// Implementation.
+		std::shared_ptr<const Memory> cells;
+		int num_cells;
+
+		// Validations.
+		static void check_program_input_stream(std::istream*);
+	};
+}
+#endif
@@ -0,0 +1,51 @@
+#include "Shift_operation.h"
+#include <sstream>
+
+namespace mix
+{
+	/*
+	* Perform a shift operation on the given machine.
+	* Shifts of rA:rX move the 10 bytes of the pair as one integer.
+	* Signs are never shifted. Negative amounts and fields that aren't
+	* shifts trap.
+	* Parameters:
+	*	mix_machine - Mix machine used to execute the instruction.
+	*	inst - Instruction to execute.
+	*/
+	void Shift_operation::execute(Machine* mix_machine, const Instruction& inst)
+	{
+		// Registers are shifted in place.
+		Word& accum{mix_machine->accumulator_ref()};
+		Word& exten{mix_machine->extension_register_ref()};
+		if (inst.address < 0) {
+			mix_machine->trap(Machine::Fault::Shift,
+							  "Cannot shift by negative amount");
+			return;
+		}
+		switch (inst.modification)
+		{
+		case Field::SLA:
+			accum.shift_left(inst.address);
+			break;
+		case Field::SRA:
+			accum.shift_right(inst.address);
+			break;
+		case Field::SLAX:
+			Word::shift_pair_left(accum, exten, inst.address);
+			break;
+		case Field::SRAX:
+			Word::shift_pair_right(accum, exten, inst.address);
+			break;
+		case Field::SLC:
+			Word::rotate_pair_left(accum, exten, inst.address);
+			break;
+		case Field::SRC:
+			Word::rotate_pair_right(accum, exten, inst.address);
+			break;
+		default:
+			std::stringstream message{};
+			message << "Invalid shift field: " << inst.modification;
+			mix_machine->trap(Machine::Fault::Field, message.str().c_str());
+		}
+	}
+}
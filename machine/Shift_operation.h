@@ -0,0 +1,21 @@
+#ifndef MIX_MACHINE_SHIFT_OPERATION_H
+#define MIX_MACHINE_SHIFT_OPERATION_H
+
+#include "Machine.h"
+#include "Operation.h"
+
+namespace mix
+{
+	// Shift operation.
+	// The field selects SLA, SRA, SLAX, SRAX, SLC or SRC,
+	// the address is the number of bytes to shift by.
+	class Shift_operation : public Operation
+	{
+	public:
+		// Fields of the shift operation.
+		enum Field : Byte { SLA, SRA, SLAX, SRAX, SLC, SRC };
+
+		void execute(Machine*, const Instruction&) override;
+	};
+}
+#endif
@@ -0,0 +1,165 @@
+#include "Snapshot.h"
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
+#ifdef MIX_SNAPSHOT_SUPPORTED
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace mix
+{
+#ifdef MIX_SNAPSHOT_SUPPORTED
+	namespace
+	{
+		// Closes a file descriptor when destroyed.
+		struct File_descriptor
+		{
+			int fd;
+			~File_descriptor()
+			{
+				if (fd != -1)
+					close(fd);
+			}
+		};
+
+		/*
+		* Write all the given bytes to the given file, retrying short
+		* and interrupted writes. Returns false on any other failure.
+		* Parameters:
+		*	fd - File descriptor, open for writing.
+		*	bytes - Bytes to write.
+		*	size - Number of bytes.
+		*/
+		bool write_all(int fd, const char* bytes, std::size_t size)
+		{
+			while (size) {
+				const ssize_t written{write(fd, bytes, size)};
+				if (written == -1) {
+					if (errno == EINTR)
+						continue;
+					return false;
+				}
+				bytes += written;
+				size -= static_cast<std::size_t>(written);
+			}
+			return true;
+		}
+
+		/*
+		* Returns the directory holding the file at the given path.
+		* Parameters:
+		*	path - Path of the file.
+		*/
+		std::string directory_of(const std::string& path)
+		{
+			const std::string::size_type slash{path.rfind('/')};
+			if (slash == std::string::npos)
+				return ".";
+			return slash == 0 ? "/" : path.substr(0, slash);
+		}
+	}
+
+	/*
+	* Write a snapshot file at the given path. The snapshot is written
+	* to a temporary file next to it, flushed to disk, then renamed over
+	* the path, so a full disk or a crash leaves the last snapshot saved
+	* there whole.
+	* If the file can't be written, throws an exception, and the path is
+	* left as it was.
+	* Parameters:
+	*	path - Path of the snapshot file.
+	*	header - Snapshot header.
+	*	cells - Packed words of memory, in address order.
+	*	num_cells - Number of memory cells.
+	*/
+	void Snapshot::write(const std::string& path, const Header& header,
+						 const Word::Packed* cells, std::size_t num_cells)
+	{
+		std::string temporary{path + ".XXXXXX"};
+		File_descriptor file{mkstemp(&temporary[0])};
+		if (file.fd == -1) {
+			throw std::runtime_error{"Cannot create " + path};
+		}
+		const bool written{
+			fchmod(file.fd, 0644) == 0
+			&& write_all(file.fd, reinterpret_cast<const char*>(&header),
+						 sizeof(header))
+			&& write_all(file.fd, reinterpret_cast<const char*>(cells),
+						 num_cells * sizeof(Word::Packed))
+			&& fsync(file.fd) == 0
+		};
+		const bool closed{close(file.fd) == 0};
+		file.fd = -1;
+		if (!written || !closed
+				|| rename(temporary.c_str(), path.c_str()) == -1) {
+			unlink(temporary.c_str());
+			throw std::runtime_error{"Cannot write " + path};
+		}
+
+		// Make the rename itself durable. Not every file system can
+		// flush a directory, and the snapshot is whole either way.
+		const File_descriptor directory{
+			open(directory_of(path).c_str(), O_RDONLY)
+		};
+		if (directory.fd != -1)
+			fsync(directory.fd);
+	}
+
+	/*
+	* Map the whole file at the given path, read-only.
+	* If the file can't be opened or mapped, throws an exception.
+	* Parameters:
+	*	path - Path of the file.
+	*/
+	Mapped_file::Mapped_file(const std::string& path)
+		: bytes{nullptr}, length{0}
+	{
+		const File_descriptor file{open(path.c_str(), O_RDONLY)};
+		struct stat status{};
+		if (file.fd == -1 || fstat(file.fd, &status) == -1) {
+			throw std::runtime_error{"Cannot open " + path};
+		}
+		length = static_cast<std::size_t>(status.st_size);
+		if (length == 0) {
+			return;
+		}
+		void* mapped{
+			mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file.fd, 0)
+		};
+		if (mapped == MAP_FAILED) {
+			throw std::runtime_error{"Cannot map " + path};
+		}
+		bytes = static_cast<char*>(mapped);
+	}
+
+	/*
+	* Unmap the file.
+	*/
+	Mapped_file::~Mapped_file()
+	{
+		if (bytes)
+			munmap(bytes, length);
+	}
+#else
+	void Snapshot::write(const std::string&, const Header&,
+						 const Word::Packed*, std::size_t)
+	{
+		throw std::runtime_error{"Snapshots need POSIX files"};
+	}
+
+	Mapped_file::Mapped_file(const std::string&)
+		: bytes{nullptr}, length{0}
+	{
+		throw std::runtime_error{"Snapshots need POSIX files"};
+	}
+
+	Mapped_file::~Mapped_file()
+	{
+	}
+#endif
+}
@@ -0,0 +1,106 @@
+#ifndef MIX_MACHINE_SNAPSHOT_H
+#define MIX_MACHINE_SNAPSHOT_H
+
+#include "Word.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Snapshot files are written through POSIX file calls, and mapped
+// into memory to be read. Elsewhere saving and restoring snapshots
+// throws.
+#if defined(__unix__) || defined(__APPLE__)
+#define MIX_SNAPSHOT_SUPPORTED
+#endif
+
+namespace mix
+{
+	// Binary snapshots of the architectural state of a machine.
+	// A snapshot is a header holding the registers and flags, followed
+	// by the packed words of memory, in address order, then by the state
+	// of each device. Everything is written in host byte order, so a
+	// snapshot restores on the host that took it, or one like it.
+	namespace Snapshot
+	{
+		// Format version, bumped on any change to the layout.
+		constexpr std::uint32_t version{1};
+
+		// Identifies a snapshot file.
+		constexpr char magic[4]{'M', 'I', 'X', 'S'};
+
+		// Snapshot header.
+		struct Header
+		{
+			// Format identification.
+			char magic[4];
+			std::uint32_t version;
+			std::uint32_t header_size;
+
+			// Machine the snapshot was taken on.
+			std::uint32_t radix;
+			std::uint32_t num_bytes;
+			std::uint32_t mem_size;
+			std::uint32_t num_devices;
+
+			// Program counter.
+			std::int32_t pc;
+
+			// Registers, packed.
+			Word::Packed accumulator;
+			Word::Packed extension;
+			Word::Packed jump;
+			Word::Packed index[6];
+
+			// Operation result flags.
+			std::uint8_t overflow;
+			std::uint8_t compare;
+			std::uint8_t reserved[6];
+		};
+
+		static_assert(std::is_trivially_copyable<Header>::value,
+					  "Snapshot headers are copied as bytes");
+		static_assert(sizeof(Header) % alignof(Word::Packed) == 0,
+					  "Memory follows the header aligned");
+
+		/*
+		* Returns the size of a snapshot of the given number of cells,
+		* in bytes.
+		* Parameters:
+		*	mem_size - Number of memory cells.
+		*/
+		constexpr std::size_t size(std::size_t mem_size)
+		{
+			return sizeof(Header) + mem_size * sizeof(Word::Packed);
+		}
+
+		// Writing a snapshot file.
+		void write(const std::string&, const Header&, const Word::Packed*,
+				   std::size_t);
+	}
+
+
+	// A file mapped read-only into memory, unmapped when destroyed.
+	class Mapped_file
+	{
+	public:
+		// Constructors and destructor.
+		explicit Mapped_file(const std::string&);
+		Mapped_file(const Mapped_file&) = delete;
+		~Mapped_file();
+
+
+		/* Functions. */
+
+		// Mapped bytes.
+		const char* data() const { return bytes; }
+		std::size_t size() const { return length; }
+
+
+	private:
+		// Implementation.
+		char* bytes;
+		std::size_t length;
+	};
+}
+#endif
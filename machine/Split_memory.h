@@ -0,0 +1,398 @@
+#ifndef MIX_MACHINE_SPLIT_MEMORY_H
+#define MIX_MACHINE_SPLIT_MEMORY_H
+
+#include "Memory.h"
+#include "Sign.h"
+#include "Word.h"
+#include <cstdint>
+
+namespace mix
+{
+	// A flat machine memory image, laid out as a structure of arrays.
+	// Magnitudes live in one dense array and signs in a separate bitmap,
+	// one bit per cell, so whole-memory scans run over plain integers.
+	// Invalid words don't fit this layout: they are marked with a flag
+	// bit in the magnitude and read back with an invalid sign and all
+	// bytes invalid.
+	template<unsigned int Num_cells>
+	class Basic_split_memory
+	{
+	public:
+		// Number of cells.
+		static const unsigned int num_cells = Num_cells;
+
+		// Writable reference to a single cell.
+		class reference;
+		using const_reference = Word;
+
+
+		// Constructor.
+		Basic_split_memory();
+
+
+		/* Operators. */
+
+		// Cell access, unchecked.
+		reference operator[](int address) { return reference{*this, address}; }
+		Word operator[](int address) const { return get(address); }
+
+
+		/* Functions. */
+
+		// Cell access, unchecked.
+		Word get(int) const;
+		void set(int, const Word&);
+		void insert_field(int, const Word&, const Field_spec&);
+
+		// Clear all cells to +0.
+		void clear();
+
+		// Whole-memory scans.
+		int first_invalid(int, int) const;
+		int first_difference(const Basic_split_memory&, int from = 0) const;
+		void write_image(char*) const;
+
+		// Whole-memory integer conversion.
+		void to_ints(long long*) const;
+		void from_ints(const long long*);
+
+		// Whole-memory packed conversion, for binary images.
+		void to_packed(Word::Packed*) const;
+		void from_packed(const Word::Packed*);
+
+
+	private:
+		// Layout of a magnitude.
+		static const unsigned int invalid_bit = 31;
+		static const std::uint32_t invalid_flag =
+			std::uint32_t{1} << invalid_bit;
+
+		// Layout of a word.
+		using Model = Word::byte_model;
+
+		static_assert(Model::binary, "Split memory needs binary bytes");
+		static_assert(Word::num_bytes * Model::size < invalid_bit,
+					  "Word magnitude does not fit in split memory");
+
+		// Number of sign bitmap words.
+		static const unsigned int num_sign_words = (Num_cells + 63) / 64;
+
+		// Implementation.
+		alignas(CACHE_LINE_SIZE) std::uint32_t magnitudes[Num_cells];
+		alignas(CACHE_LINE_SIZE) std::uint64_t signs[num_sign_words];
+
+		// Helper functions.
+		bool is_minus(int) const;
+		static Word invalid_word();
+	};
+
+
+	// Writable reference to a single cell of a split memory.
+	// Reads assemble the word, writes scatter it back.
+	template<unsigned int Num_cells>
+	class Basic_split_memory<Num_cells>::reference
+	{
+	public:
+		reference(Basic_split_memory& m, int a) : memory{m}, address{a} {}
+		reference(const reference&) = default;
+
+		operator Word() const { return memory.get(address); }
+		bool operator==(const Word& w) const
+		{
+			return memory.get(address) == w;
+		}
+
+		reference& operator=(const Word& w)
+		{
+			memory.set(address, w);
+			return *this;
+		}
+
+		reference& operator=(const reference& r)
+		{
+			return *this = static_cast<Word>(r);
+		}
+
+	private:
+		Basic_split_memory& memory;
+		int address;
+	};
+
+
+	/*
+	* Construct a memory image with all cells cleared to +0.
+	* Template parameters:
+	*	N - Number of cells.
+	*/
+	template<unsigned int N>
+	Basic_split_memory<N>::Basic_split_memory()
+		: magnitudes{}, signs{}
+	{
+	}
+
+	/*
+	* Returns the word at the given address.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*/
+	template<unsigned int N>
+	Word Basic_split_memory<N>::get(int address) const
+	{
+		const std::uint32_t m{magnitudes[address]};
+		if (m & invalid_flag)
+			return invalid_word();
+		const Sign s{is_minus(address) ? Sign::Minus : Sign::Plus};
+		return Word::from_magnitude(s, m);
+	}
+
+	/*
+	* Write the given word at the given address.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	w - Word to write.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::set(int address, const Word& w)
+	{
+		const std::uint64_t bit{std::uint64_t{1} << (address % 64)};
+		std::uint32_t m{static_cast<std::uint32_t>(w.magnitude())};
+		if (!w.is_valid())
+			m |= invalid_flag;
+		magnitudes[address] = m;
+		if (w.sign() == Sign::Minus)
+			signs[address / 64] |= bit;
+		else
+			signs[address / 64] &= ~bit;
+	}
+
+	/*
+	* Write the right-most bytes of the given word into a field of the
+	* cell at the given address. The cell is rebuilt from its magnitude
+	* and sign, since it isn't stored as a word.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*	w - Word to write.
+	*	field - Field of the cell to write.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::insert_field(int address,
+											 const Word& w,
+											 const Field_spec& field)
+	{
+		Word cell{get(address)};
+		cell.insert_field(w, field);
+		set(address, cell);
+	}
+
+	/*
+	* Clear all cells to +0.
+	* Template parameters:
+	*	N - Number of cells.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::clear()
+	{
+		for (std::uint32_t& m : magnitudes)
+			m = 0;
+		for (std::uint64_t& s : signs)
+			s = 0;
+	}
+
+	/*
+	* Returns the address of the first invalid word in [first, last),
+	* or last if all words in the range are valid.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	first - First address to check.
+	*	last - One past the last address to check.
+	*/
+	template<unsigned int N>
+	int Basic_split_memory<N>::first_invalid(int first, int last) const
+	{
+		for (int block = first; block < last; block += SCAN_BLOCK_SIZE) {
+			const int end{block + SCAN_BLOCK_SIZE < last ?
+						  block + SCAN_BLOCK_SIZE : last};
+
+			// Branch-free check of a whole block, then find the cell.
+			std::uint32_t flags{0};
+			for (int i = block; i < end; ++i)
+				flags |= magnitudes[i];
+			if (!(flags & invalid_flag))
+				continue;
+			for (int i = block; i < end; ++i) {
+				if (magnitudes[i] & invalid_flag)
+					return i;
+			}
+		}
+		return last;
+	}
+
+	/*
+	* Returns the first address, starting at from, whose cell differs
+	* from the same cell of the given memory, or N if there is none.
+	* Blocks are aligned to the sign bitmap, so each block compares
+	* a run of magnitudes and a single sign word.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	other - Memory to compare to.
+	*	from - First address to compare.
+	*/
+	template<unsigned int N>
+	int Basic_split_memory<N>::first_difference
+			(const Basic_split_memory& other, int from) const
+	{
+		static_assert(SCAN_BLOCK_SIZE == 64,
+					  "Scan blocks must match sign bitmap words");
+		const int size{static_cast<int>(N)};
+		for (int block = from - from % 64; block < size; block += 64) {
+			const int end{block + 64 < size ? block + 64 : size};
+
+			// Branch-free check of a whole block, then find the cell.
+			std::uint32_t differs{0};
+			for (int i = block; i < end; ++i)
+				differs |= magnitudes[i] ^ other.magnitudes[i];
+			if (!differs && signs[block / 64] == other.signs[block / 64])
+				continue;
+			for (int i = (block < from ? from : block); i < end; ++i) {
+				if (magnitudes[i] != other.magnitudes[i]
+						|| is_minus(i) != other.is_minus(i))
+					return i;
+			}
+		}
+		return size;
+	}
+
+	/*
+	* Write the text image of all cells, in address order, into the given
+	* buffer of N * WORD_IMAGE_SIZE characters. Each word is written as
+	* its sign followed by its bytes, as by operator<<.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer to write into.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::write_image(char* out) const
+	{
+		const Word invalid{invalid_word()};
+		for (unsigned int i = 0; i < N; ++i) {
+			const std::uint32_t m{magnitudes[i]};
+			if (m & invalid_flag) {
+				*out++ = static_cast<char>(invalid.sign());
+				for (int b = 1; b <= Word::num_bytes; ++b)
+					*out++ = static_cast<char>(invalid.byte(b));
+				continue;
+			}
+			*out++ = static_cast<char>(is_minus(i) ? Sign::Minus : Sign::Plus);
+			for (int b = Word::num_bytes - 1; b >= 0; --b) {
+				const std::uint32_t byte{m >> (b * Model::size)};
+				*out++ = static_cast<char>(byte & Model::mask);
+			}
+		}
+	}
+
+	/*
+	* Convert all cells, in address order, to integers.
+	* Magnitudes are the values already, so only signs are applied.
+	* Invalid cells convert to 0, as their bytes read back invalid.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer of N integers.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::to_ints(long long* out) const
+	{
+		for (unsigned int i = 0; i < N; ++i) {
+			const std::uint32_t m{magnitudes[i]};
+			const long long magnitude{
+				(m & invalid_flag) ? 0 : static_cast<long long>(m)
+			};
+			const long long minus{
+				static_cast<long long>((signs[i / 64] >> (i % 64)) & 1)
+			};
+			out[i] = (magnitude ^ -minus) + minus;
+		}
+	}
+
+	/*
+	* Set all cells, in address order, from integers.
+	* If an integer doesn't fit in a word, throws an exception
+	* before any cell is written.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	values - Buffer of N integers.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::from_ints(const long long* values)
+	{
+		check_ints(values, values + N);
+		for (unsigned int i = 0; i < N; ++i)
+			set(i, Word{values[i]});
+	}
+
+	/*
+	* Copy the packed representation of all cells, in address order.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	out - Buffer of N packed words.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::to_packed(Word::Packed* out) const
+	{
+		for (unsigned int i = 0; i < N; ++i)
+			out[i] = get(i).packed();
+	}
+
+	/*
+	* Set all cells, in address order, from their packed representation.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	values - Buffer of N packed words.
+	*/
+	template<unsigned int N>
+	void Basic_split_memory<N>::from_packed(const Word::Packed* values)
+	{
+		for (unsigned int i = 0; i < N; ++i)
+			set(i, Word::from_packed(values[i]));
+	}
+
+	/*
+	* Returns whether the cell at the given address is negative.
+	* Template parameters:
+	*	N - Number of cells.
+	* Parameters:
+	*	address - Memory address, in range [0, N).
+	*/
+	template<unsigned int N>
+	bool Basic_split_memory<N>::is_minus(int address) const
+	{
+		return (signs[address / 64] >> (address % 64)) & 1;
+	}
+
+	/*
+	* Returns the word read back from an invalid cell.
+	* Template parameters:
+	*	N - Number of cells.
+	*/
+	template<unsigned int N>
+	Word Basic_split_memory<N>::invalid_word()
+	{
+		Word w{Sign::Invalid};
+		for (int i = 1; i <= Word::num_bytes; ++i)
+			w.byte(i) = INVALID_BYTE;
+		return w;
+	}
+}
+#endif
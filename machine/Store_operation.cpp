@@ -11,68 +11,47 @@ namespace mix
 	*/
 	void Store_operation::execute(Machine* mix_machine, const Instruction& inst)
 	{
-		Word content{};
-		Word mem_cell{mix_machine->memory_cell(inst.address)};
+		// Word registers are stored from where they are. Index and jump
+		// registers are widened to a word first.
+		Word widened{};
+		const Word* reg{&widened};
 		switch (inst.op_code)
 		{
 		case Op_code::STA:
-			content = register_content(mix_machine->accumulator(), inst);
+			reg = &mix_machine->accumulator();
 			break;
 		case Op_code::ST1:
-			content = register_content(mix_machine->index_register(1), inst);
+			widened = mix_machine->fetch_index(1);
 			break;
 		case Op_code::ST2:
-			content = register_content(mix_machine->index_register(2), inst);
+			widened = mix_machine->fetch_index(2);
 			break;
 		case Op_code::ST3:
-			content = register_content(mix_machine->index_register(3), inst);
+			widened = mix_machine->fetch_index(3);
 			break;
 		case Op_code::ST4:
-			content = register_content(mix_machine->index_register(4), inst);
+			widened = mix_machine->fetch_index(4);
 			break;
 		case Op_code::ST5:
-			content = register_content(mix_machine->index_register(5), inst);
+			widened = mix_machine->fetch_index(5);
 			break;
 		case Op_code::ST6:
-			content = register_content(mix_machine->index_register(6), inst);
+			widened = mix_machine->fetch_index(6);
 			break;
 		case Op_code::STX:
-			content = register_content(mix_machine->extension_register(), inst);
+			reg = &mix_machine->extension_register();
 			break;
 		case Op_code::STJ:
-			content = register_content(mix_machine->jump_register(), inst);
+			widened = mix_machine->jump_register();
 			break;
 		case Op_code::STZ:
-			// Store zero, so no need to change content.
+			// Store zero, so no need to read a register.
 			break;
 		default:
 			std::stringstream message{};
 			message << "Op code is not a store operation: " << inst.op_code;
 			throw std::invalid_argument{message.str()};
 		}
-		mem_cell.copy_range(content, inst.field);
-		mix_machine->memory_cell(inst.address, mem_cell);
-	}
-
-	/*
-	* Get the contents of the given register.
-	* Parameters:
-	*	reg - Register.
-	*	inst - Instruction.
-	*/
-	Word Store_operation::register_content(const Word& reg,
-										   const Instruction& inst) const
-	{
-		Word content{};
-		if (inst.field.contains_sign()) {
-			content = reg.rightmost_with_sign(inst.field.bytes());
-		}
-		else {
-			content = reg.rightmost_bytes(inst.field.bytes());
-		}
-		int shift_amount{static_cast<int>(Word::num_bytes) - inst.field.right};
-		content.shift_left(shift_amount);
-		return content;
+		mix_machine->store_field(inst.address, *reg, inst.field);
 	}
 }
-
@@ -11,9 +11,6 @@ namespace mix
 	{
 	public:
 		void execute(Machine*, const Instruction&) override;
-
-	private:
-		Word register_content(const Word&, const Instruction&) const;
 	};
 }
 #endif
@@ -0,0 +1,139 @@
+#include "Superinstructions.h"
+#include "Arithmetic.h"
+#include "Machine.h"
+
+namespace mix
+{
+	namespace Superinstructions
+	{
+		namespace
+		{
+			/*
+			* Returns whether the given word is an instruction with the
+			* given op code that can't fault: it is unindexed, its address
+			* is in memory, and its field is valid.
+			* Parameters:
+			*	w - Word to check.
+			*	code - Expected op code.
+			*/
+			bool is_safe(const Word& w, Op_code code)
+			{
+				if (!w.is_valid() || get_op_code(w) != code)
+					return false;
+				if (get_index_spec(w) != 0)
+					return false;
+				const int address{get_address(w)};
+				const int size{static_cast<int>(Machine::mem_size)};
+				if (address < 0 || size <= address)
+					return false;
+				const int encoded{w.byte(FIELD_SPEC)};
+				const int left{encoded / Field_spec::ENCODE_VALUE};
+				const int right{encoded % Field_spec::ENCODE_VALUE};
+				return left <= right && right <= Word::num_bytes;
+			}
+
+			/*
+			* Execute LDA, then ADD or SUB, then STA.
+			* Template parameters:
+			*	Code - Arithmetic op code, ADD or SUB.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instructions.
+			*	entries - Predecoded LDA, arithmetic and STA instructions.
+			*/
+			template<Op_code Code>
+			void execute_load_math_store(Machine* mix_machine,
+										 const Predecoded* entries)
+			{
+				const Instruction load{entries[0].instruction()};
+				const Instruction math{entries[1].instruction()};
+				const Instruction store{entries[2].instruction()};
+				const Word loaded{
+					mix_machine->fetch(load.address)
+						.field_aligned_right(load.field)
+				};
+				const Word operand{
+					mix_machine->fetch(math.address)
+						.field_aligned_right(math.field)
+				};
+				const Word_result result{
+					Code == Op_code::ADD ? add(loaded, operand)
+										 : subtract(loaded, operand)
+				};
+				mix_machine->accumulator(result.value);
+				if (result.overflow) {
+					mix_machine->overflow_bit(Machine::Bit::On);
+				}
+				mix_machine->store_field(store.address, result.value,
+										 store.field);
+			}
+
+			/*
+			* Execute a load of a register, then a store of it.
+			* Template parameters:
+			*	Load - Load op code, LDA or LDX.
+			* Parameters:
+			*	mix_machine - Mix machine used to execute the instructions.
+			*	entries - Predecoded load and store instructions.
+			*/
+			template<Op_code Load>
+			void execute_load_store(Machine* mix_machine,
+									const Predecoded* entries)
+			{
+				const Instruction load{entries[0].instruction()};
+				const Instruction store{entries[1].instruction()};
+				const Word loaded{
+					mix_machine->fetch(load.address)
+						.field_aligned_right(load.field)
+				};
+				if constexpr (Load == Op_code::LDA)
+					mix_machine->accumulator(loaded);
+				else
+					mix_machine->extension_register(loaded);
+				mix_machine->store_field(store.address, loaded, store.field);
+			}
+
+			// Ids of the superinstructions.
+			enum Id : Byte
+			{
+				Add_id = NO_HANDLER + 1, Sub_id, Lda_sta_id, Ldx_stx_id
+			};
+		}
+
+		// Superinstruction handlers, indexed by id.
+		const std::array<Fused_handler, NUM_HANDLERS> handlers{
+			nullptr,
+			execute_load_math_store<Op_code::ADD>,
+			execute_load_math_store<Op_code::SUB>,
+			execute_load_store<Op_code::LDA>,
+			execute_load_store<Op_code::LDX>
+		};
+
+		/*
+		* Returns the superinstruction starting with the first of the
+		* given words, if any. The longest one found is returned.
+		* Parameters:
+		*	cells - Words of consecutive memory cells.
+		*	count - Number of words, at most MAX_FUSED_LENGTH.
+		*/
+		Fusion find(const Word* cells, int count)
+		{
+			if (count >= 3
+					&& is_safe(cells[0], Op_code::LDA)
+					&& is_safe(cells[2], Op_code::STA)) {
+				if (is_safe(cells[1], Op_code::ADD))
+					return {Add_id, 3};
+				if (is_safe(cells[1], Op_code::SUB))
+					return {Sub_id, 3};
+			}
+			if (count >= 2) {
+				if (is_safe(cells[0], Op_code::LDA)
+						&& is_safe(cells[1], Op_code::STA))
+					return {Lda_sta_id, 2};
+				if (is_safe(cells[0], Op_code::LDX)
+						&& is_safe(cells[1], Op_code::STX))
+					return {Ldx_stx_id, 2};
+			}
+			return {NO_HANDLER, 0};
+		}
+	}
+}
@@ -0,0 +1,50 @@
+#ifndef MIX_MACHINE_SUPERINSTRUCTIONS_H
+#define MIX_MACHINE_SUPERINSTRUCTIONS_H
+
+#include "Decode_cache.h"
+#include "Word.h"
+#include <array>
+
+namespace mix
+{
+	// Superinstructions: common runs of instructions fused into one
+	// handler, so the run loop dispatches once for the whole run.
+	// Only runs that can't fault are fused: every instruction is
+	// unindexed, with an address in memory and a valid field. A fused run
+	// then leaves the machine exactly as executing its instructions one
+	// at a time would, and no fault can stop it half way.
+	namespace Superinstructions
+	{
+		// A superinstruction found at some address.
+		struct Fusion
+		{
+			// Id of the handler, or NO_HANDLER if there is no
+			// superinstruction.
+			Byte handler;
+
+			// Number of cells fused.
+			int length;
+		};
+
+		// Number of handler ids, NO_HANDLER included.
+		constexpr int NUM_HANDLERS{5};
+
+		// Superinstruction handlers, indexed by id.
+		extern const std::array<Fused_handler, NUM_HANDLERS> handlers;
+
+		// Returns the superinstruction starting with the first
+		// of the given words, if any.
+		Fusion find(const Word*, int);
+
+		/*
+		* Returns the superinstruction handler with the given id.
+		* Parameters:
+		*	id - Id of a superinstruction handler.
+		*/
+		inline Fused_handler handler(Byte id)
+		{
+			return handlers[id];
+		}
+	}
+}
+#endif
@@ -0,0 +1,319 @@
+#include "Translator.h"
+#include "Decoder.h"
+#include "Instruction.h"
+#include "Machine.h"
+#include "Op_code.h"
+#include "Program_image.h"
+#include "Word.h"
+#include <stdexcept>
+#include <vector>
+
+namespace mix
+{
+	namespace Translator
+	{
+		namespace
+		{
+			// Mnemonics, indexed by op code.
+			const char* const mnemonics[]{
+				"", "ADD", "SUB", "MUL", "DIV", "", "SFT", "",
+				"LDA", "LD1", "LD2", "LD3", "LD4", "LD5", "LD6", "LDX",
+				"LDAN", "LD1N", "LD2N", "LD3N", "LD4N", "LD5N", "LD6N", "LDXN",
+				"STA", "ST1", "ST2", "ST3", "ST4", "ST5", "ST6", "STX",
+				"STJ", "STZ"
+			};
+
+			/*
+			* Read a program image, as Machine::load_program does.
+			* Parameters:
+			*	program - Stream to read the program from.
+			*/
+			std::vector<Word> read_image(std::istream* program)
+			{
+				const Program_image loaded{program};
+				std::vector<Word> image(loaded.size());
+				for (int address = 0; address < loaded.size(); ++address)
+					image[address] = loaded[address];
+				return image;
+			}
+
+			/*
+			* Returns the address of the first cell of the given image
+			* that isn't translated: the first that doesn't decode, or
+			* whose op code has no operation.
+			* Parameters:
+			*	image - Program image.
+			*/
+			int translated_end(const std::vector<Word>& image)
+			{
+				int end{0};
+				while (end < static_cast<int>(image.size())
+						&& Decoder::decode(image[end]).status
+							== Decode_status::Valid)
+					++end;
+				return end;
+			}
+
+			/*
+			* Write the given word as a C++ expression.
+			* Parameters:
+			*	os - Stream to write to.
+			*	word - Word to write.
+			*/
+			void write_word(std::ostream& os, const Word& word)
+			{
+				os << "Word{Sign::"
+				   << (word.sign() == Sign::Minus ? "Minus" : "Plus") << ", {";
+				for (unsigned int i = 1; i <= Word::num_bytes; ++i) {
+					os << (i == 1 ? "" : ", ")
+					   << static_cast<int>(word.byte(i));
+				}
+				os << "}}";
+			}
+
+			/*
+			* Write the address of the given instruction as a C++
+			* expression, offset by its index register if it has one.
+			* Parameters:
+			*	os - Stream to write to.
+			*	inst - Unindexed instruction.
+			*/
+			void write_address(std::ostream& os, const Instruction& inst)
+			{
+				os << inst.address;
+				if (inst.index_spec != 0) {
+					os << " + get_address(m.fetch_index(" << inst.index_spec
+					   << "))";
+				}
+			}
+
+			/*
+			* Write the given field specification as a C++ expression.
+			* Parameters:
+			*	os - Stream to write to.
+			*	field - Field specification.
+			*/
+			void write_field(std::ostream& os, const Field_spec& field)
+			{
+				os << "Field_spec{" << field.left << ", " << field.right << '}';
+			}
+
+			/*
+			* Write a load: the field is loaded straight into the register.
+			* Parameters:
+			*	os - Stream to write to.
+			*	inst - Unindexed load instruction.
+			*/
+			void write_load(std::ostream& os, const Instruction& inst)
+			{
+				const int reg{inst.op_code - Op_code::LDA};
+				if (inst.op_code == Op_code::LDA) {
+					os << "\tm.accumulator(";
+				}
+				else if (inst.op_code == Op_code::LDX) {
+					os << "\tm.extension_register(";
+				}
+				else {
+					os << "\tm.store_index(" << reg << ", ";
+				}
+				os << "m.memory_content(";
+				write_address(os, inst);
+				os << ", ";
+				write_field(os, inst.field);
+				os << "));\n";
+			}
+
+			/*
+			* Write a store: the register is inserted into the field of
+			* the cell, in place.
+			* Parameters:
+			*	os - Stream to write to.
+			*	inst - Unindexed store instruction.
+			*/
+			void write_store(std::ostream& os, const Instruction& inst)
+			{
+				os << "\ta = ";
+				write_address(os, inst);
+				os << ";\n\tm.store_field(a, ";
+				switch (inst.op_code)
+				{
+				case Op_code::STA:
+					os << "m.accumulator()";
+					break;
+				case Op_code::STX:
+					os << "m.extension_register()";
+					break;
+				case Op_code::STJ:
+					os << "static_cast<Word>(m.jump_register())";
+					break;
+				case Op_code::STZ:
+					os << "Word{}";
+					break;
+				default:
+					os << "static_cast<Word>(m.fetch_index("
+					   << inst.op_code - Op_code::STA << "))";
+				}
+				os << ", ";
+				write_field(os, inst.field);
+				os << ");\n";
+			}
+
+			/*
+			* Write an instruction executed by its operation.
+			* Parameters:
+			*	os - Stream to write to.
+			*	inst - Unindexed instruction.
+			*	operation - Name of the operation type.
+			*/
+			void write_operation(std::ostream& os,
+								 const Instruction& inst,
+								 const char* operation)
+			{
+				os << '\t' << operation << "{}.execute(&m, Instruction{";
+				write_address(os, inst);
+				os << ", " << inst.index_spec << ", ";
+				write_field(os, inst.field);
+				os << ", " << inst.modification << ", Op_code::"
+				   << mnemonics[inst.op_code] << "});\n";
+			}
+
+			/*
+			* Write the translation of the instruction at the given address.
+			* The translation returns if the instruction faults, and after
+			* a store that may have written over translated cells. Returns
+			* whether the translation can go on after the instruction.
+			* Parameters:
+			*	os - Stream to write to.
+			*	address - Address of the instruction.
+			*	inst - Unindexed instruction.
+			*	end - Address of the first cell that isn't translated.
+			*/
+			bool write_instruction(std::ostream& os,
+								   int address,
+								   const Instruction& inst,
+								   int end)
+			{
+				os << "\n\t// " << address << ": "
+				   << mnemonics[inst.op_code] << ' ' << inst.address << ','
+				   << inst.index_spec << '(' << inst.field.left << ':'
+				   << inst.field.right << ")\n";
+				os << "\tnext = " << address + 1 << ";\n";
+				const Op_kind kind{op_kind(inst.op_code)};
+				switch (kind)
+				{
+				case Op_kind::Load:
+					write_load(os, inst);
+					break;
+				case Op_kind::Store:
+					write_store(os, inst);
+					break;
+				case Op_kind::Math:
+					write_operation(os, inst, "Math_operation");
+					break;
+				case Op_kind::Shift:
+					write_operation(os, inst, "Shift_operation");
+					break;
+				default:
+					write_operation(os, inst, "Load_neg_operation");
+				}
+
+				// Loads and stores of whole fields at a fixed address
+				// in memory can't fault.
+				const bool can_fault{
+					inst.index_spec != 0
+						|| (kind != Op_kind::Load && kind != Op_kind::Store)
+						|| Machine::mem_size
+							<= static_cast<unsigned int>(inst.address)
+						|| Word::num_bytes
+							< static_cast<unsigned int>(inst.field.right)
+				};
+				if (can_fault) {
+					os << "\tif (m.fault() != Machine::Fault::None) return;\n";
+				}
+				if (kind == Op_kind::Store) {
+					if (inst.index_spec != 0) {
+						os << "\tif (0 <= a && a < " << end << ") return;\n";
+					}
+					else if (0 <= inst.address && inst.address < end) {
+						os << "\treturn;\n";
+						return false;
+					}
+				}
+				return true;
+			}
+		}
+
+		/*
+		* Translate a program to C++.
+		* Each translated instruction sets the resume address to the cell
+		* following it before it runs, so the interpreter takes over at
+		* the right cell wherever the translation returns or throws.
+		* Parameters:
+		*	program - Stream to read the program image from.
+		*	output - Stream to write the translation unit to.
+		*/
+		void translate(std::istream* program, std::ostream* output)
+		{
+			const std::vector<Word> image{read_image(program)};
+			const int end{translated_end(image)};
+			std::ostream& os{*output};
+
+			os << "// Translated by mix-translate.\n"
+			   << "#include \"Machine.h\"\n"
+			   << "#include \"Operations.h\"\n"
+			   << "#include <iostream>\n\n"
+			   << "using namespace mix;\n\n"
+			   << "namespace\n{\n"
+			   << "const Word image[]{\n";
+			for (const Word& word : image) {
+				os << '\t';
+				write_word(os, word);
+				os << ",\n";
+			}
+			os << "};\n\n"
+			   << "void run(Machine& m, int& next)\n{\n";
+			for (int address = 0; address < end; ++address) {
+				if (Decoder::decode(image[address]).kind == Op_kind::Store) {
+					os << "\tint a{0};\n";
+					break;
+				}
+			}
+			bool goes_on{true};
+			for (int address = 0; goes_on && address < end; ++address) {
+				const Decoded_instruction decoded{
+					Decoder::decode(image[address])
+				};
+				goes_on = write_instruction(os, address,
+											Decoder::to_instruction(decoded),
+											end);
+			}
+			if (goes_on) {
+				os << "\n\tnext = " << end << ";\n";
+			}
+			os << "}\n"
+			   << "}\n\n"
+			   << "int main(int argc, char* argv[])\n{\n"
+			   << "\ttry {\n"
+			   << "\t\tstatic Machine machine{};\n"
+			   << "\t\tfor (int i = 0; i < " << image.size() << "; ++i)\n"
+			   << "\t\t\tmachine.memory_cell(i, image[i]);\n"
+			   << "\t\tint status{0};\n"
+			   << "\t\ttry {\n"
+			   << "\t\t\tmachine.run_program(run);\n"
+			   << "\t\t}\n"
+			   << "\t\tcatch (std::invalid_argument& e) {\n"
+			   << "\t\t\tstd::cout << e.what() << std::endl;\n"
+			   << "\t\t\tstatus = -1;\n"
+			   << "\t\t}\n"
+			   << "\t\tif (argc > 1)\n"
+			   << "\t\t\tmachine.save_snapshot(argv[1]);\n"
+			   << "\t\treturn status;\n"
+			   << "\t}\n"
+			   << "\tcatch (std::exception& e) {\n"
+			   << "\t\tstd::cout << e.what() << std::endl;\n"
+			   << "\t\treturn -1;\n"
+			   << "\t}\n"
+			   << "}\n";
+		}
+	}
+}
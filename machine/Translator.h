@@ -0,0 +1,27 @@
+#ifndef MIX_MACHINE_TRANSLATOR_H
+#define MIX_MACHINE_TRANSLATOR_H
+
+#include <iostream>
+
+namespace mix
+{
+	// Ahead-of-time translation of MIX programs into C++.
+	// A program image, in the format Machine::load_program reads, becomes
+	// a standalone translation unit: the image, a Translated_program
+	// running its instructions as straight-line C++ on the machine's word
+	// and arithmetic primitives, and a main loading and running it. Built
+	// with the machine sources, it runs the program as mix-machine does,
+	// and saves a snapshot of the final state to the file named by its
+	// first argument, as mix-machine does with its second.
+	// Translation stops at the first cell that doesn't decode, or whose
+	// op code has no operation, and the embedded interpreter takes over
+	// there. It also takes over after any store into a translated cell,
+	// so self-modifying code runs what it wrote.
+	namespace Translator
+	{
+		// Translates the program read from the given stream,
+		// and writes the translation unit to the other.
+		void translate(std::istream*, std::ostream*);
+	}
+}
+#endif
@@ -2,11 +2,22 @@
 #define MIX_MACHINE_WORD_H
 
 #include "Basic_word.h"
+#include "Byte.h"
 
 namespace mix
 {
-	using Word = Basic_word<5>;
-	using Half_word = Basic_word<2>;
-}
+	// Machine byte model, selected at build time.
+	// "make decimal=1" builds the decimal machine. One model is built
+	// into a program: Machine and everything built on Word use it, so a
+	// binary and a decimal machine can't run in the same process. Only
+	// Basic_word itself is generic over the byte model.
+#ifdef MIX_DECIMAL
+	using Machine_byte = Decimal_byte;
+#else
+	using Machine_byte = Binary_byte;
 #endif
 
+	using Word = Basic_word<5, Machine_byte>;
+	using Half_word = Basic_word<2, Machine_byte>;
+}
+#endif
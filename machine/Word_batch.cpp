@@ -0,0 +1,329 @@
+#include "Word_batch.h"
+#include <cstdint>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#define MIX_AVX2_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace mix
+{
+	namespace
+	{
+		using Packed = Word::Packed;
+
+		// Kernels work on the packed representation directly.
+		static_assert(sizeof(Word) == sizeof(Packed),
+					  "Word is not exactly its packed representation");
+
+		// Layout of a packed word.
+		constexpr Field_spec ALL_BYTES{1, Word::num_bytes};
+		constexpr Packed MAGNITUDE{Word::field_masks(ALL_BYTES).magnitude};
+		constexpr Packed MINUS{Word{Sign::Minus}.packed()};
+		constexpr Packed SIGN{Word::field_masks({0, 0}).sign};
+		constexpr Packed INVALID{
+			Word{Sign::Invalid}.packed() | Word::field_masks(ALL_BYTES).flags
+		};
+
+		// Whether the packed magnitude is the word's value.
+		constexpr bool BINARY{Word::byte_model::binary};
+
+
+		/* Scalar kernels. */
+
+		/*
+		* Convert the words in [first, last) to integers.
+		* Parameters:
+		*	first - First word.
+		*	last - One past the last word.
+		*	out - Integers, one per word.
+		*/
+		void scalar_to_ints(const Word* first, const Word* last,
+							long long* out)
+		{
+			for (; first != last; ++first) {
+				if constexpr (BINARY) {
+					const Packed p{first->packed()};
+					const long long magnitude{
+						static_cast<long long>(p & MAGNITUDE)
+					};
+					*out++ = (p & SIGN) == MINUS ? -magnitude : magnitude;
+				}
+				else {
+					*out++ = first->to_int();
+				}
+			}
+		}
+
+		/*
+		* Returns whether the given integer fits in a word.
+		* Parameters:
+		*	n - Integer.
+		*/
+		constexpr bool fits(long long n)
+		{
+			const std::uint64_t magnitude{
+				n < 0 ? std::uint64_t{0} - static_cast<std::uint64_t>(n)
+					  : static_cast<std::uint64_t>(n)
+			};
+			return magnitude < Word::modulus();
+		}
+
+		/*
+		* Check that the integers in [first, last) fit in words.
+		* If one doesn't, throws an exception.
+		* Parameters:
+		*	first - First integer.
+		*	last - One past the last integer.
+		*/
+		void scalar_check_ints(const long long* first, const long long* last)
+		{
+			for (; first != last; ++first) {
+				if (!fits(*first))
+					throw_int_too_big(*first);
+			}
+		}
+
+		/*
+		* Convert the integers in [first, last), which all fit, to words.
+		* Parameters:
+		*	first - First integer.
+		*	last - One past the last integer.
+		*	out - Words, one per integer.
+		*/
+		void scalar_from_ints(const long long* first, const long long* last,
+							  Word* out)
+		{
+			for (; first != last; ++first)
+				*out++ = Word{*first};
+		}
+
+		/*
+		* Returns the first invalid word in [first, last), or last.
+		* Parameters:
+		*	first - First word.
+		*	last - One past the last word.
+		*/
+		const Word* scalar_find_invalid(const Word* first, const Word* last)
+		{
+			for (; first != last; ++first) {
+				if (first->packed() & INVALID)
+					return first;
+			}
+			return last;
+		}
+
+
+#ifdef MIX_AVX2_KERNELS
+		/* Avx2 kernels, four words per vector. */
+
+		/*
+		* Returns the magnitudes of the given integers, and sets the
+		* mask of their negative lanes. Negative lanes are (n ^ -1) + 1;
+		* the smallest integer keeps its bits, which are too big unsigned.
+		*/
+		__attribute__((target("avx2")))
+		__m256i avx2_abs(__m256i n, __m256i& negative)
+		{
+			negative = _mm256_cmpgt_epi64(_mm256_setzero_si256(), n);
+			return _mm256_sub_epi64(_mm256_xor_si256(n, negative), negative);
+		}
+
+		/*
+		* Convert the words in [first, last) to integers.
+		* Negative values are (magnitude ^ -1) + 1, selected per lane.
+		*/
+		__attribute__((target("avx2")))
+		void avx2_to_ints(const Word* first, const Word* last, long long* out)
+		{
+			const __m256i magnitude{_mm256_set1_epi64x(MAGNITUDE)};
+			const __m256i sign{_mm256_set1_epi64x(SIGN)};
+			const __m256i minus{_mm256_set1_epi64x(MINUS)};
+			for (; last - first >= 4; first += 4, out += 4) {
+				const __m256i w{_mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>(first))};
+				const __m256i m{_mm256_and_si256(w, magnitude)};
+				const __m256i negative{
+					_mm256_cmpeq_epi64(_mm256_and_si256(w, sign), minus)};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out),
+					_mm256_sub_epi64(_mm256_xor_si256(m, negative), negative));
+			}
+			scalar_to_ints(first, last, out);
+		}
+
+		/*
+		* Check that the integers in [first, last) fit in words.
+		* Out of range integers are collected across the whole range,
+		* then reported by the scalar kernel.
+		*/
+		__attribute__((target("avx2")))
+		void avx2_check_ints(const long long* first, const long long* last)
+		{
+			const long long* const begin{first};
+			const __m256i bias{_mm256_set1_epi64x(INT64_MIN)};
+			const __m256i max{_mm256_set1_epi64x(Word::int_max() ^ INT64_MIN)};
+			__m256i too_big{_mm256_setzero_si256()};
+			for (; last - first >= 4; first += 4) {
+				const __m256i n{_mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>(first))};
+				__m256i negative{};
+				const __m256i magnitude{avx2_abs(n, negative)};
+
+				// Unsigned compare, so that the smallest integer is too big.
+				too_big = _mm256_or_si256(too_big, _mm256_cmpgt_epi64(
+					_mm256_xor_si256(magnitude, bias), max));
+			}
+			if (!_mm256_testz_si256(too_big, too_big))
+				scalar_check_ints(begin, first);
+			scalar_check_ints(first, last);
+		}
+
+		/*
+		* Convert the integers in [first, last), which all fit, to words.
+		*/
+		__attribute__((target("avx2")))
+		void avx2_from_ints(const long long* first, const long long* last,
+							Word* out)
+		{
+			const __m256i minus{_mm256_set1_epi64x(MINUS)};
+			for (; last - first >= 4; first += 4, out += 4) {
+				const __m256i n{_mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>(first))};
+				__m256i negative{};
+				const __m256i magnitude{avx2_abs(n, negative)};
+				const __m256i w{_mm256_or_si256(
+					magnitude, _mm256_and_si256(negative, minus))};
+				_mm256_storeu_si256(reinterpret_cast<__m256i*>(out), w);
+			}
+			scalar_from_ints(first, last, out);
+		}
+
+		/*
+		* Returns the first invalid word in [first, last), or last.
+		* Eight words are tested at once, the scalar kernel finds
+		* which one is invalid.
+		*/
+		__attribute__((target("avx2")))
+		const Word* avx2_find_invalid(const Word* first, const Word* last)
+		{
+			const __m256i invalid{_mm256_set1_epi64x(INVALID)};
+			for (; last - first >= 8; first += 8) {
+				const __m256i a{_mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>(first))};
+				const __m256i b{_mm256_loadu_si256(
+					reinterpret_cast<const __m256i*>(first + 4))};
+				if (!_mm256_testz_si256(_mm256_or_si256(a, b), invalid))
+					return scalar_find_invalid(first, first + 8);
+			}
+			return scalar_find_invalid(first, last);
+		}
+#endif
+
+		/*
+		* Returns whether the avx2 kernels should run.
+		* Parameters:
+		*	kernel - Requested kernel.
+		*/
+		bool use_avx2(Batch_kernel kernel)
+		{
+			return BINARY && kernel == Batch_kernel::Avx2
+				&& best_batch_kernel() == Batch_kernel::Avx2;
+		}
+	}
+
+	/*
+	* Returns the fastest kernel supported by this cpu.
+	* Checked once, on first use.
+	*/
+	Batch_kernel best_batch_kernel()
+	{
+#ifdef MIX_AVX2_KERNELS
+		static const bool avx2{__builtin_cpu_supports("avx2") != 0};
+		if (avx2)
+			return Batch_kernel::Avx2;
+#endif
+		return Batch_kernel::Scalar;
+	}
+
+	/*
+	* Convert the words in [first, last) to integers, as by to_int().
+	* Parameters:
+	*	first - First word.
+	*	last - One past the last word.
+	*	out - Integers, one per word.
+	*	kernel - Kernel to use.
+	*/
+	void to_ints(const Word* first, const Word* last, long long* out,
+				 Batch_kernel kernel)
+	{
+#ifdef MIX_AVX2_KERNELS
+		if (use_avx2(kernel)) {
+			avx2_to_ints(first, last, out);
+			return;
+		}
+#endif
+		scalar_to_ints(first, last, out);
+	}
+
+	/*
+	* Check that the integers in [first, last) fit in words, as by
+	* Basic_word(long long). If one doesn't, throws an exception.
+	* Parameters:
+	*	first - First integer.
+	*	last - One past the last integer.
+	*	kernel - Kernel to use.
+	*/
+	void check_ints(const long long* first, const long long* last,
+					Batch_kernel kernel)
+	{
+#ifdef MIX_AVX2_KERNELS
+		if (use_avx2(kernel)) {
+			avx2_check_ints(first, last);
+			return;
+		}
+#endif
+		scalar_check_ints(first, last);
+	}
+
+	/*
+	* Convert the integers in [first, last) to words, as by
+	* Basic_word(long long).
+	* All integers are checked first: if one doesn't fit in a word,
+	* throws an exception before any word is written.
+	* Parameters:
+	*	first - First integer.
+	*	last - One past the last integer.
+	*	out - Words, one per integer.
+	*	kernel - Kernel to use.
+	*/
+	void from_ints(const long long* first, const long long* last, Word* out,
+				   Batch_kernel kernel)
+	{
+		check_ints(first, last, kernel);
+#ifdef MIX_AVX2_KERNELS
+		if (use_avx2(kernel)) {
+			avx2_from_ints(first, last, out);
+			return;
+		}
+#endif
+		scalar_from_ints(first, last, out);
+	}
+
+	/*
+	* Returns the first word in [first, last) that is not valid,
+	* as by is_valid(), or last if all words are valid.
+	* Parameters:
+	*	first - First word.
+	*	last - One past the last word.
+	*	kernel - Kernel to use.
+	*/
+	const Word* find_invalid(const Word* first, const Word* last,
+							 Batch_kernel kernel)
+	{
+#ifdef MIX_AVX2_KERNELS
+		if (use_avx2(kernel))
+			return avx2_find_invalid(first, last);
+#endif
+		return scalar_find_invalid(first, last);
+	}
+}
@@ -0,0 +1,30 @@
+#ifndef MIX_MACHINE_WORD_BATCH_H
+#define MIX_MACHINE_WORD_BATCH_H
+
+#include "Byte.h"
+#include "Word.h"
+
+namespace mix
+{
+	// Kernels of the batch word functions.
+	// Avx2 is used only by binary words, on cpus that support it;
+	// otherwise the scalar kernel runs.
+	enum class Batch_kernel : Byte { Scalar, Avx2 };
+
+	// Returns the fastest kernel supported by this cpu.
+	Batch_kernel best_batch_kernel();
+
+	// Converting ranges of words to and from integers. Conversions
+	// from integers check them all before writing any word.
+	void check_ints(const long long*, const long long*,
+					Batch_kernel = best_batch_kernel());
+	void to_ints(const Word*, const Word*, long long*,
+				 Batch_kernel = best_batch_kernel());
+	void from_ints(const long long*, const long long*, Word*,
+				   Batch_kernel = best_batch_kernel());
+
+	// Finding the first invalid word of a range.
+	const Word* find_invalid(const Word*, const Word*,
+							 Batch_kernel = best_batch_kernel());
+}
+#endif
@@ -0,0 +1,445 @@
+#include "X86_emitter.h"
+
+namespace mix
+{
+	namespace
+	{
+		// Low three bits of a register encoding, used in ModRM bytes.
+		Byte low(X86_emitter::Reg r)
+		{
+			return r & 0x7;
+		}
+
+		// Whether a register needs a REX extension bit.
+		bool extended(X86_emitter::Reg r)
+		{
+			return r >= X86_emitter::r8;
+		}
+	}
+
+	/*
+	* Construct an emitter writing into the given buffer.
+	* Parameters:
+	*	buffer - Buffer to emit into.
+	*	size - Size of the buffer, in bytes.
+	*/
+	X86_emitter::X86_emitter(Byte* buffer, int size)
+		: code{buffer}, capacity{size}, used{0}, overflow{false}
+	{
+	}
+
+	/*
+	* Emit push reg.
+	* Parameters:
+	*	r - Register to push.
+	*/
+	void X86_emitter::push(Reg r)
+	{
+		if (extended(r))
+			emit(0x41);
+		emit(0x50 + low(r));
+	}
+
+	/*
+	* Emit pop reg.
+	* Parameters:
+	*	r - Register to pop.
+	*/
+	void X86_emitter::pop(Reg r)
+	{
+		if (extended(r))
+			emit(0x41);
+		emit(0x58 + low(r));
+	}
+
+	/*
+	* Emit mov dst, src, on 64 bits.
+	* Parameters:
+	*	dst - Destination register.
+	*	src - Source register.
+	*/
+	void X86_emitter::mov(Reg dst, Reg src)
+	{
+		rex(true, src, dst);
+		emit(0x89);
+		emit(0xC0 | low(src) << 3 | low(dst));
+	}
+
+	/*
+	* Emit mov dst, imm64.
+	* Parameters:
+	*	dst - Destination register.
+	*	imm - Immediate value.
+	*/
+	void X86_emitter::mov(Reg dst, std::uint64_t imm)
+	{
+		rex(true, rax, dst);
+		emit(0xB8 + low(dst));
+		emit64(imm);
+	}
+
+	/*
+	* Emit mov dst, imm32, on 32 bits.
+	* Parameters:
+	*	dst - Destination register.
+	*	imm - Immediate value.
+	*/
+	void X86_emitter::mov32(Reg dst, std::uint32_t imm)
+	{
+		if (extended(dst))
+			emit(0x41);
+		emit(0xB8 + low(dst));
+		emit32(imm);
+	}
+
+	/*
+	* Emit lea dst, [base + disp32].
+	* Parameters:
+	*	dst - Destination register.
+	*	b - Base register.
+	*	disp - Displacement.
+	*/
+	void X86_emitter::lea(Reg dst, Reg b, std::int32_t disp)
+	{
+		rex(true, dst, b);
+		emit(0x8D);
+		memory(dst, b, disp);
+	}
+
+	/*
+	* Emit mov dst, [base + disp32], on 64 bits.
+	* Parameters:
+	*	dst - Destination register.
+	*	b - Base register.
+	*	disp - Displacement.
+	*/
+	void X86_emitter::load(Reg dst, Reg b, std::int32_t disp)
+	{
+		rex(true, dst, b);
+		emit(0x8B);
+		memory(dst, b, disp);
+	}
+
+	/*
+	* Emit mov [base + disp32], src, on 64 bits.
+	* Parameters:
+	*	b - Base register.
+	*	disp - Displacement.
+	*	src - Source register.
+	*/
+	void X86_emitter::store(Reg b, std::int32_t disp, Reg src)
+	{
+		rex(true, src, b);
+		emit(0x89);
+		memory(src, b, disp);
+	}
+
+	/*
+	* Emit mov byte [base + disp32], imm8.
+	* Parameters:
+	*	b - Base register.
+	*	disp - Displacement.
+	*	imm - Immediate value.
+	*/
+	void X86_emitter::store8(Reg b, std::int32_t disp, Byte imm)
+	{
+		// The reg field holds the opcode extension, 0.
+		rex(false, rax, b);
+		emit(0xC6);
+		memory(rax, b, disp);
+		emit(imm);
+	}
+
+	/*
+	* Emit cmp byte [base + disp32], imm8.
+	* Parameters:
+	*	b - Base register.
+	*	disp - Displacement.
+	*	imm - Immediate value.
+	*/
+	void X86_emitter::cmp8(Reg b, std::int32_t disp, Byte imm)
+	{
+		// The reg field holds the opcode extension, 7.
+		rex(false, rax, b);
+		emit(0x80);
+		memory(rdi, b, disp);
+		emit(imm);
+	}
+
+	/*
+	* Emit cmp dword [base + disp32], imm8, with the immediate
+	* sign extended.
+	* Parameters:
+	*	b - Base register.
+	*	disp - Displacement.
+	*	imm - Immediate value.
+	*/
+	void X86_emitter::cmp32(Reg b, std::int32_t disp, Byte imm)
+	{
+		// The reg field holds the opcode extension, 7.
+		rex(false, rax, b);
+		emit(0x83);
+		memory(rdi, b, disp);
+		emit(imm);
+	}
+
+	/*
+	* Emit op dst, src, on 64 bits.
+	* Parameters:
+	*	op - Arithmetic or logic instruction.
+	*	dst - Destination register.
+	*	src - Source register.
+	*/
+	void X86_emitter::alu(Alu op, Reg dst, Reg src)
+	{
+		rex(true, src, dst);
+		emit(op);
+		emit(0xC0 | low(src) << 3 | low(dst));
+	}
+
+	/*
+	* Emit op reg, imm8, on 64 bits.
+	* Parameters:
+	*	op - Shift instruction.
+	*	r - Register to shift.
+	*	count - Number of bits to shift by.
+	*/
+	void X86_emitter::shift(Shift op, Reg r, Byte count)
+	{
+		rex(true, rax, r);
+		emit(0xC1);
+		emit(0xC0 | op << 3 | low(r));
+		emit(count);
+	}
+
+	/*
+	* Emit neg reg, on 64 bits.
+	* Parameters:
+	*	r - Register to negate.
+	*/
+	void X86_emitter::neg(Reg r)
+	{
+		rex(true, rax, r);
+		emit(0xF7);
+		emit(0xD8 | low(r));
+	}
+
+	/*
+	* Emit test a, b, on 64 bits.
+	* Parameters:
+	*	a - First register.
+	*	b - Second register.
+	*/
+	void X86_emitter::test(Reg a, Reg b)
+	{
+		rex(true, b, a);
+		emit(0x85);
+		emit(0xC0 | low(b) << 3 | low(a));
+	}
+
+	/*
+	* Emit cmovcc dst, src, on 64 bits.
+	* Parameters:
+	*	cond - Condition of the move.
+	*	dst - Destination register.
+	*	src - Source register.
+	*/
+	void X86_emitter::cmov(Condition cond, Reg dst, Reg src)
+	{
+		rex(true, dst, src);
+		emit(0x0F);
+		emit(0x40 + cond);
+		emit(0xC0 | low(dst) << 3 | low(src));
+	}
+
+	/*
+	* Emit call reg.
+	* Parameters:
+	*	target - Register holding the address to call.
+	*/
+	void X86_emitter::call(Reg target)
+	{
+		if (extended(target))
+			emit(0x41);
+		emit(0xFF);
+		emit(0xD0 | low(target));
+	}
+
+	/*
+	* Emit call [base + disp8].
+	* Parameters:
+	*	b - Base register.
+	*	disp - Displacement.
+	*/
+	void X86_emitter::call(Reg b, std::int8_t disp)
+	{
+		if (extended(b))
+			emit(0x41);
+		emit(0xFF);
+		emit(0x50 | low(b));
+		base(b);
+		emit(static_cast<Byte>(disp));
+	}
+
+	/*
+	* Emit call rel32 to the given target, if it is within reach of
+	* the next instruction. Returns whether it was.
+	* Parameters:
+	*	target - Address to call.
+	*/
+	bool X86_emitter::call(const void* target)
+	{
+		const std::intptr_t next{
+			reinterpret_cast<std::intptr_t>(code + used + 5)
+		};
+		const std::intptr_t displacement{
+			reinterpret_cast<std::intptr_t>(target) - next
+		};
+		if (displacement != static_cast<std::int32_t>(displacement))
+			return false;
+		emit(0xE8);
+		emit32(static_cast<std::uint32_t>(displacement));
+		return true;
+	}
+
+	/*
+	* Emit test reg8, reg8, on the low byte of rax, rcx, rdx or rbx.
+	* Parameters:
+	*	r - Register to test.
+	*/
+	void X86_emitter::test8(Reg r)
+	{
+		emit(0x84);
+		emit(0xC0 | low(r) << 3 | low(r));
+	}
+
+	/*
+	* Emit a conditional jump, and return the position of its
+	* displacement, to bind once the target is known.
+	* Parameters:
+	*	cond - Condition of the jump.
+	*/
+	int X86_emitter::jump(Condition cond)
+	{
+		emit(0x0F);
+		emit(0x80 + cond);
+		emit32(0);
+		return used - 4;
+	}
+
+	/*
+	* Emit an unconditional jump, and return the position of its
+	* displacement, to bind once the target is known.
+	*/
+	int X86_emitter::jump()
+	{
+		emit(0xE9);
+		emit32(0);
+		return used - 4;
+	}
+
+	/*
+	* Emit ret.
+	*/
+	void X86_emitter::ret()
+	{
+		emit(0xC3);
+	}
+
+	/*
+	* Make the jump with the displacement at the given position jump to
+	* the given position.
+	* Parameters:
+	*	jump_at - Position returned when emitting the jump.
+	*	target - Position to jump to.
+	*/
+	void X86_emitter::bind(int jump_at, int target)
+	{
+		if (overflow)
+			return;
+		const std::uint32_t displacement{
+			static_cast<std::uint32_t>(target - (jump_at + 4))
+		};
+		for (int i = 0; i < 4; ++i)
+			code[jump_at + i] = static_cast<Byte>(displacement >> 8 * i);
+	}
+
+	/*
+	* Emit the given byte.
+	* Parameters:
+	*	b - Byte to emit.
+	*/
+	void X86_emitter::emit(Byte b)
+	{
+		if (used == capacity) {
+			overflow = true;
+			return;
+		}
+		code[used++] = b;
+	}
+
+	/*
+	* Emit the given 32 bit value, little endian.
+	* Parameters:
+	*	value - Value to emit.
+	*/
+	void X86_emitter::emit32(std::uint32_t value)
+	{
+		for (int i = 0; i < 4; ++i)
+			emit(static_cast<Byte>(value >> 8 * i));
+	}
+
+	/*
+	* Emit the given 64 bit value, little endian.
+	* Parameters:
+	*	value - Value to emit.
+	*/
+	void X86_emitter::emit64(std::uint64_t value)
+	{
+		for (int i = 0; i < 8; ++i)
+			emit(static_cast<Byte>(value >> 8 * i));
+	}
+
+	/*
+	* Emit a REX prefix, if needed.
+	* Parameters:
+	*	wide - Whether the operation is on 64 bits.
+	*	reg - Register of the ModRM reg field.
+	*	rm - Register of the ModRM rm field, or of the opcode.
+	*/
+	void X86_emitter::rex(bool wide, Reg reg, Reg rm)
+	{
+		const Byte prefix{static_cast<Byte>(
+			0x40 | wide << 3 | extended(reg) << 2 | extended(rm)
+		)};
+		if (prefix != 0x40)
+			emit(prefix);
+	}
+
+	/*
+	* Emit the SIB byte a ModRM byte with the given base needs, if any:
+	* rsp and r12 bases can only be encoded through one.
+	* Parameters:
+	*	b - Base register.
+	*/
+	void X86_emitter::base(Reg b)
+	{
+		if (low(b) == rsp)
+			emit(0x24);
+	}
+
+	/*
+	* Emit the ModRM byte, SIB byte and displacement of a [base + disp32]
+	* memory operand.
+	* Parameters:
+	*	reg - Register, or opcode extension, of the ModRM reg field.
+	*	b - Base register.
+	*	disp - Displacement.
+	*/
+	void X86_emitter::memory(Reg reg, Reg b, std::int32_t disp)
+	{
+		emit(0x80 | low(reg) << 3 | low(b));
+		base(b);
+		emit32(static_cast<std::uint32_t>(disp));
+	}
+}
@@ -0,0 +1,93 @@
+#ifndef MIX_MACHINE_X86_EMITTER_H
+#define MIX_MACHINE_X86_EMITTER_H
+
+#include "Byte.h"
+#include <cstdint>
+
+namespace mix
+{
+	// Emitter of the few x86-64 instructions the JIT needs, encoded
+	// into a caller-supplied buffer. Instructions that don't fit set the
+	// overflow flag and are dropped, so a full buffer is found by one
+	// check after emitting.
+	class X86_emitter
+	{
+	public:
+		// 64 bit general purpose registers, by encoding.
+		enum Reg : Byte {
+			rax, rcx, rdx, rbx, rsp, rbp, rsi, rdi,
+			r8, r9, r10, r11, r12, r13, r14, r15
+		};
+
+		// Condition codes of conditional jumps and moves.
+		enum Condition : Byte {
+			above_equal = 0x3, zero = 0x4, not_zero = 0x5,
+			below_equal = 0x6, sign = 0x8
+		};
+
+		// Two operand arithmetic and logic instructions, by opcode.
+		enum Alu : Byte {
+			add = 0x01, bit_or = 0x09, bit_and = 0x21, bit_xor = 0x31,
+			cmp = 0x39
+		};
+
+		// Shifts by an immediate count, by ModRM extension.
+		enum Shift : Byte { shl = 0x4, shr = 0x5 };
+
+
+		// Constructor.
+		X86_emitter(Byte*, int);
+
+
+		/* Functions. */
+
+		// Instructions.
+		void push(Reg);
+		void pop(Reg);
+		void mov(Reg, Reg);
+		void mov(Reg, std::uint64_t);
+		void mov32(Reg, std::uint32_t);
+		void lea(Reg, Reg, std::int32_t);
+		void load(Reg, Reg, std::int32_t);
+		void store(Reg, std::int32_t, Reg);
+		void store8(Reg, std::int32_t, Byte);
+		void cmp8(Reg, std::int32_t, Byte);
+		void cmp32(Reg, std::int32_t, Byte);
+		void alu(Alu, Reg, Reg);
+		void shift(Shift, Reg, Byte);
+		void neg(Reg);
+		void test(Reg, Reg);
+		void cmov(Condition, Reg, Reg);
+		void call(Reg);
+		void call(Reg, std::int8_t);
+		bool call(const void*);
+		void test8(Reg);
+		int jump(Condition);
+		int jump();
+		void ret();
+
+		// Jump targets.
+		void bind(int, int);
+
+		// Accessors.
+		int size() const { return used; }
+		bool overflowed() const { return overflow; }
+
+
+	private:
+		// Implementation.
+		Byte* code;
+		int capacity;
+		int used;
+		bool overflow;
+
+		// Helper functions.
+		void emit(Byte);
+		void emit32(std::uint32_t);
+		void emit64(std::uint64_t);
+		void rex(bool, Reg, Reg);
+		void base(Reg);
+		void memory(Reg, Reg, std::int32_t);
+	};
+}
+#endif
@@ -0,0 +1,86 @@
+#include "../Decoder.h"
+#include "../Instruction.h"
+#include "../Machine.h"
+#include "../Word.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mix;
+
+// Measures decoding whole images, in nanoseconds per word. Compares
+// decoding each word with decode_unindexed to the table decoder. Each
+// decoder is timed over several trials, and the fastest is reported,
+// which filters out noise from other work on the host.
+
+namespace
+{
+	const int trials{20};
+	const int repetitions{200};
+
+	using Clock = std::chrono::steady_clock;
+
+	/*
+	* Run the given decoder repeatedly over the image and print its
+	* best time per word over all trials.
+	* Template parameters:
+	*	Decode - Callable decoding the image once.
+	* Parameters:
+	*	name - Name of the decoder.
+	*	words - Number of words of the image.
+	*	decode - Decoder to run.
+	*/
+	template<typename Decode>
+	void time(const std::string& name, int words, Decode decode)
+	{
+		double best{0};
+		for (int trial = 0; trial < trials; ++trial) {
+			const Clock::time_point start{Clock::now()};
+			for (int i = 0; i < repetitions; ++i)
+				decode();
+			const std::chrono::duration<double, std::nano> elapsed{
+				Clock::now() - start};
+			if (trial == 0 || elapsed.count() < best)
+				best = elapsed.count();
+		}
+		std::cout << name << ": "
+				  << best / (static_cast<double>(words) * repetitions)
+				  << " ns/word\n";
+	}
+}
+
+int main()
+{
+	// A full memory image of valid loads and stores, of every field,
+	// so decoding reads across the whole tables.
+	std::vector<Field_spec> fields{};
+	for (int right = 0; right <= static_cast<int>(Word::num_bytes); ++right)
+		for (int left = 0; left <= right; ++left)
+			fields.push_back(Field_spec{left, right});
+	std::vector<Word> image{};
+	for (unsigned int i = 0; i < Machine::mem_size; ++i) {
+		const Op_code code{static_cast<Op_code>(Op_code::LDA + i % 26)};
+		const Field_spec& field{fields[i / 26 % fields.size()]};
+		image.push_back(encode({static_cast<int>(i), 0, field,
+								field.encode(), code}));
+	}
+	const int words{static_cast<int>(image.size())};
+
+	std::vector<Instruction> instructions(image.size());
+	time("Word decoder", words, [&] {
+		for (int i = 0; i < words; ++i)
+			instructions[i] = decode_unindexed(image[i]);
+	});
+	std::vector<Decoded_instruction> decoded(image.size());
+	time("Table decoder", words, [&] {
+		Decoder::decode(image.data(), image.data() + words, decoded.data());
+	});
+
+	// Keep the results alive.
+	long long sum{0};
+	for (int i = 0; i < words; ++i)
+		sum += instructions[i].address + decoded[i].address;
+	std::cout << "(checksum " << sum << ")\n";
+	return 0;
+}
@@ -0,0 +1,84 @@
+#include "../Instruction.h"
+#include "../Machine.h"
+#include "../Op_code.h"
+#include "../Word.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using namespace mix;
+
+// Measures interpreter throughput, in millions of instructions per second,
+// running a straight-line program that fills memory. Compares stepping
+// with execute_next_instruction to the threaded run_program loop, with
+// the JIT off and on.
+
+namespace
+{
+	// Last cell of the program, left empty so running it faults.
+	const int program_size{Machine::mem_size - 100};
+	const int repetitions{2000};
+
+	using Clock = std::chrono::steady_clock;
+
+	/*
+	* Load a program of loads, adds, stores and shifts into the machine.
+	* Data lives in the last cells of memory.
+	* Parameters:
+	*	machine - Machine to load.
+	*/
+	void load(Machine& machine)
+	{
+		const int data{program_size + 1};
+		const Instruction body[]{
+			{data, 0, {0, 5}, 5, Op_code::LDA},
+			{data + 1, 0, {0, 5}, 5, Op_code::ADD},
+			{data + 2, 0, {0, 5}, 5, Op_code::STA},
+			{1, 0, {0, 3}, 3, Op_code::SFT},
+			{data + 2, 0, {4, 5}, 37, Op_code::LDX},
+			{data + 3, 0, {0, 5}, 5, Op_code::STX}
+		};
+		const int body_size{sizeof(body) / sizeof(body[0])};
+		for (int i = 0; i < program_size; ++i)
+			machine.memory_cell(i, encode(body[i % body_size]));
+		machine.memory_cell(data, Word{123456});
+		machine.memory_cell(data + 1, Word{-789});
+	}
+
+	/*
+	* Run the given loop repeatedly and print its throughput.
+	* Template parameters:
+	*	Run - Callable running the program once.
+	* Parameters:
+	*	name - Name of the loop.
+	*	run - Loop to run.
+	*/
+	template<typename Run>
+	void time(const std::string& name, Run run)
+	{
+		const Clock::time_point start{Clock::now()};
+		for (int i = 0; i < repetitions; ++i)
+			run();
+		const std::chrono::duration<double, std::micro> elapsed{
+			Clock::now() - start};
+		const double instructions{
+			static_cast<double>(program_size + 1) * repetitions};
+		std::cout << name << ": " << instructions / elapsed.count()
+				  << " MIPS\n";
+	}
+}
+
+int main()
+{
+	static Machine machine{};
+	load(machine);
+	time("Stepping", [&] {
+		machine.program_counter(0);
+		for (int i = 0; i <= program_size; ++i)
+			machine.execute_next_instruction();
+	});
+	time("Threaded run", [&] { machine.run_program(); });
+	machine.jit_mode(Machine::Jit_mode::On);
+	time("JIT run", [&] { machine.run_program(); });
+	return 0;
+}
@@ -0,0 +1,133 @@
+#include "../Memory.h"
+#include "../Split_memory.h"
+#include "../Word.h"
+#include "../Word_batch.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace mix;
+
+// Compares whole-memory scans over the array-of-structs layout
+// (Basic_memory) and the structure-of-arrays layout (Basic_split_memory),
+// and the scalar and avx2 batch word kernels.
+
+namespace
+{
+	const unsigned int num_cells{4000};
+	const int repetitions{20000};
+
+	using Clock = std::chrono::steady_clock;
+
+	// Keeps results alive so the scans aren't optimized away.
+	volatile long sink{0};
+
+	// Integer image of a memory.
+	std::vector<long long> values(num_cells);
+
+	/*
+	* Fill the given memory with a mix of positive and negative words.
+	* Template parameters:
+	*	Memory - Memory layout.
+	* Parameters:
+	*	memory - Memory to fill.
+	*/
+	template<typename Memory>
+	void fill(Memory& memory)
+	{
+		for (unsigned int i = 0; i < num_cells; ++i) {
+			const int value{static_cast<int>(i * 2654435761u % 1000000)};
+			memory[i] = Word{i % 3 ? value : -value};
+		}
+	}
+
+	/*
+	* Run the given scan repeatedly and print its mean time.
+	* Template parameters:
+	*	Scan - Callable returning a value to sink.
+	* Parameters:
+	*	name - Name of the scan.
+	*	scan - Scan to run.
+	*/
+	template<typename Scan>
+	void time(const std::string& name, Scan scan)
+	{
+		const Clock::time_point start{Clock::now()};
+		for (int i = 0; i < repetitions; ++i)
+			sink = sink + scan();
+		const std::chrono::duration<double, std::micro> elapsed{
+			Clock::now() - start};
+		std::cout << name << ": " << elapsed.count() / repetitions
+				  << " us\n";
+	}
+
+	/*
+	* Benchmark all whole-memory scans on one memory layout.
+	* Template parameters:
+	*	Memory - Memory layout.
+	* Parameters:
+	*	layout - Name of the layout.
+	*/
+	template<typename Memory>
+	void benchmark(const std::string& layout)
+	{
+		static Memory a{};
+		static Memory b{};
+		fill(a);
+		fill(b);
+		b[num_cells - 1] = Word{Sign::Minus};
+		std::string image(num_cells * WORD_IMAGE_SIZE, '\0');
+
+		std::cout << layout << " (" << sizeof(Memory) << " bytes)\n";
+		time("  dump", [&] {
+			a.write_image(&image[0]);
+			return image[WORD_IMAGE_SIZE];
+		});
+		time("  validate", [&] { return a.first_invalid(0, num_cells); });
+		time("  diff", [&] { return a.first_difference(b); });
+		time("  to ints", [&] {
+			a.to_ints(values.data());
+			return values[1];
+		});
+	}
+
+	/*
+	* Benchmark the batch word kernels on a full memory image.
+	* Parameters:
+	*	kernel - Kernel to run.
+	*	name - Name of the kernel.
+	*/
+	void benchmark_kernel(Batch_kernel kernel, const std::string& name)
+	{
+		std::vector<Word> words(num_cells);
+		for (unsigned int i = 0; i < num_cells; ++i)
+			words[i] = Word{static_cast<int>(i * 2654435761u % 1000000)};
+		const Word* first{words.data()};
+		const Word* last{first + num_cells};
+
+		std::cout << name << " kernel\n";
+		time("  to ints", [&] {
+			to_ints(first, last, values.data(), kernel);
+			return values[1];
+		});
+		time("  from ints", [&] {
+			from_ints(values.data(), values.data() + num_cells,
+					  words.data(), kernel);
+			return words[1].packed();
+		});
+		time("  validate", [&] {
+			return find_invalid(first, last, kernel) - first;
+		});
+	}
+}
+
+int main()
+{
+	benchmark<Basic_memory<num_cells>>("Array of structs");
+	benchmark<Basic_split_memory<num_cells>>("Structure of arrays");
+	benchmark_kernel(Batch_kernel::Scalar, "Scalar");
+	if (best_batch_kernel() == Batch_kernel::Avx2)
+		benchmark_kernel(Batch_kernel::Avx2, "Avx2");
+	return 0;
+}
@@ -0,0 +1,174 @@
+#include "catch.hpp"
+#include "Helpers.h"
+#include "../Arithmetic.h"
+#include "../Word.h"
+
+using namespace mix;
+
+SCENARIO("Adding words")
+{
+	GIVEN("Two words that sum to zero")
+	{
+		const Word a{Sign::Minus, {0, 0, 0, 0, 5}};
+		const Word v{Sign::Plus, {0, 0, 0, 0, 5}};
+		WHEN("Added")
+		{
+			const Word_result sum{add(a, v)};
+			THEN("The sum is zero, with the sign of the first word")
+			{
+				REQUIRE(sum.value.sign() == Sign::Minus);
+				REQUIRE(sum.value.magnitude() == 0);
+				REQUIRE(sum.overflow == false);
+			}
+		}
+	}
+	GIVEN("Two words whose sum doesn't fit in a word")
+	{
+		const Word a{Word::int_min()};
+		const Word v{Sign::Minus, {0, 0, 0, 0, 1}};
+		WHEN("Added")
+		{
+			const Word_result sum{add(a, v)};
+			THEN("The sum wraps around, overflow is set")
+			{
+				REQUIRE(sum.value.sign() == Sign::Minus);
+				REQUIRE(sum.value.magnitude() == 0);
+				REQUIRE(sum.overflow == true);
+			}
+		}
+	}
+}
+
+SCENARIO("Subtracting words")
+{
+	GIVEN("Two words")
+	{
+		const Word a{Sign::Plus, {0, 0, 0, 1, 0}};
+		const Word v{Sign::Plus, {0, 0, 0, 0, 1}};
+		WHEN("Subtracted")
+		{
+			const Word_result difference{subtract(v, a)};
+			THEN("The difference is correct")
+			{
+				REQUIRE(difference.value.to_int()
+						== -(Word::byte_model::radix - 1));
+				REQUIRE(difference.overflow == false);
+			}
+		}
+	}
+}
+
+SCENARIO("Multiplying words")
+{
+	GIVEN("Two words of the largest magnitude")
+	{
+		const Word a{Word::int_max()};
+		const Word v{Word::int_min()};
+		WHEN("Multiplied")
+		{
+			const Double_word_result product{multiply(a, v)};
+			THEN("The 10-byte product is exact")
+			{
+				// (2^30 - 1)^2 = 2^60 - 2^31 + 1
+				REQUIRE(product.high.sign() == Sign::Minus);
+				REQUIRE(product.high.to_int(1, 5) == Word::int_max() - 1);
+				REQUIRE(product.low.sign() == Sign::Minus);
+				REQUIRE(product.low.to_int(1, 5) == 1);
+				REQUIRE(product.overflow == false);
+			}
+		}
+	}
+	GIVEN("A zero product")
+	{
+		const Word a{Sign::Minus, {}};
+		const Word v{Sign::Plus, {0, 0, 0, 0, 3}};
+		WHEN("Multiplied")
+		{
+			const Double_word_result product{multiply(a, v)};
+			THEN("The zero product still has the sign of the product")
+			{
+				REQUIRE(product.high.sign() == Sign::Minus);
+				REQUIRE(product.low.sign() == Sign::Minus);
+			}
+		}
+	}
+}
+
+SCENARIO("Dividing words")
+{
+	GIVEN("A dividend whose quotient doesn't fit in a word")
+	{
+		const Word high{Sign::Plus, {0, 0, 0, 0, 3}};
+		const Word low{};
+		const Word v{Sign::Plus, {0, 0, 0, 0, 3}};
+		WHEN("Divided")
+		{
+			const Double_word_result quotient{divide(high, low, v)};
+			THEN("Overflow is set, and the dividend is unchanged")
+			{
+				REQUIRE(quotient.overflow == true);
+				REQUIRE(quotient.high == high);
+				REQUIRE(quotient.low == low);
+			}
+		}
+	}
+	GIVEN("A negative dividend and a negative divisor")
+	{
+		const Word high{Sign::Minus, {}};
+		const Word low{Sign::Plus, {0, 0, 0, 0, 17}};
+		const Word v{Sign::Minus, {0, 0, 0, 0, 5}};
+		WHEN("Divided")
+		{
+			const Double_word_result quotient{divide(high, low, v)};
+			THEN("The quotient is positive, the remainder negative")
+			{
+				REQUIRE(quotient.high.to_int() == 3);
+				REQUIRE(quotient.low.sign() == Sign::Minus);
+				REQUIRE(quotient.low.to_int() == -2);
+			}
+		}
+	}
+}
+
+SCENARIO("Decimal arithmetic")
+{
+	using Decimal_word = Basic_word<5, Decimal_byte>;
+	GIVEN("The largest decimal word")
+	{
+		const Decimal_word max{Sign::Plus, {99, 99, 99, 99, 99}};
+		WHEN("Squared")
+		{
+			const Basic_double_word_result<Decimal_word> product{
+				multiply(max, max)
+			};
+			THEN("The product spans both words in base 100")
+			{
+				require_bytes_are(product.high, {99, 99, 99, 99, 98});
+				require_bytes_are(product.low, {0, 0, 0, 0, 1});
+			}
+			AND_WHEN("Divided back by the word")
+			{
+				const Basic_double_word_result<Decimal_word> quotient{
+					divide(product.high, product.low, max)
+				};
+				THEN("The quotient is the word, with no remainder")
+				{
+					REQUIRE(quotient.overflow == false);
+					REQUIRE(quotient.high == max);
+					REQUIRE(quotient.low.magnitude() == 0);
+				}
+			}
+		}
+		WHEN("One is added")
+		{
+			const Basic_word_result<Decimal_word> sum{
+				add(max, Decimal_word{1})
+			};
+			THEN("The sum wraps around to zero, overflow is set")
+			{
+				REQUIRE(sum.value.magnitude() == 0);
+				REQUIRE(sum.overflow == true);
+			}
+		}
+	}
+}
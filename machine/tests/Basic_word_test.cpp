@@ -2,6 +2,9 @@
 #include "Helpers.h"
 #include "../Basic_word.h"
 #include "../Field_spec.h"
+#include <cmath>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 #include <string>
 
@@ -478,7 +481,7 @@ SCENARIO("Converting a range to an integer", "[A]")
 		Basic_word<2> bw{Sign::Plus, {0x1f, 0x10}};
 		WHEN("Converting whole word to integer")
 		{
-			int i{bw.to_int()};
+			long long i{bw.to_int()};
 			THEN("The integer is 2000")
 			{
 				REQUIRE(i == 2000);
@@ -490,7 +493,7 @@ SCENARIO("Converting a range to an integer", "[A]")
 		Basic_word<5> bw{Sign::Plus, {0, 0x1f, 0x10, 0, 20}};
 		WHEN("Converting range of [2,3] to integer")
 		{
-			int i{bw.to_int(2, 3)};
+			long long i{bw.to_int(2, 3)};
 			THEN("The integer is 2000")
 			{
 				REQUIRE(i == 2000);
@@ -502,7 +505,7 @@ SCENARIO("Converting a range to an integer", "[A]")
 		Basic_word<5> bw{Sign::Minus, {1, 2, 3, 4, 5}};
 		WHEN("Converting range of [1, 4] to integer")
 		{
-			int i{bw.to_int(1, 4)};
+			long long i{bw.to_int(1, 4)};
 			THEN("The integer is 270532")
 			{
 				REQUIRE(i == 270532);
@@ -517,7 +520,7 @@ SCENARIO("Converting a range to an integer", "[A]")
 		}
 		WHEN("Converting a range of [0, 4] to integer")
 		{
-			int i{bw.to_int(0, 4)};
+			long long i{bw.to_int(0, 4)};
 			THEN("The integer is -270532")
 			{
 				REQUIRE(i == -270532);
@@ -756,7 +759,7 @@ SCENARIO("Int max")
 {
 	WHEN("Asking for the maximum integer value of a basic word")
 	{
-		int max{Basic_word<5>::int_max()};
+		long long max{Basic_word<5>::int_max()};
 		THEN("The returned value is accurate")
 		{
 			REQUIRE(max == static_cast<int>(std::pow(2, 30)) - 1);
@@ -768,7 +771,7 @@ SCENARIO("Int min")
 {
 	WHEN("Asking for the minimum integer value of a basic word")
 	{
-		int min{Basic_word<5>::int_min()};
+		long long min{Basic_word<5>::int_min()};
 		THEN("The returned value is accurate")
 		{
 			REQUIRE(min == -(static_cast<int>(std::pow(2, 30)) - 1));
@@ -802,7 +805,7 @@ SCENARIO("Constructing from an int")
 		}
 		WHEN("Constructing from an int which is too large")
 		{
-			int value{Basic_word<5>::int_max() + 1};
+			long long value{Basic_word<5>::int_max() + 1};
 			THEN("An invalid argument exception is thrown")
 			{
 				REQUIRE_THROWS_AS(
@@ -813,7 +816,7 @@ SCENARIO("Constructing from an int")
 		}
 		WHEN("Constructing from a negative int which is too large")
 		{
-			int value{-(Basic_word<5>::int_max() + 1)};
+			long long value{-(Basic_word<5>::int_max() + 1)};
 			THEN("An invalid argument exception is thrown")
 			{
 				REQUIRE_THROWS_AS(
@@ -822,5 +825,283 @@ SCENARIO("Constructing from an int")
 				);
 			}
 		}
+		WHEN("Constructing from the smallest int")
+		{
+			const int value{std::numeric_limits<int>::min()};
+			THEN("A binary word throws, a decimal word holds it")
+			{
+				REQUIRE_THROWS_AS(
+					Basic_word<5>{value},
+					std::invalid_argument
+				);
+				const Basic_word<5, Decimal_byte> bw{value};
+				REQUIRE(bw.sign() == Sign::Minus);
+				REQUIRE(bw.magnitude() == 2147483648);
+			}
+		}
+	}
+}
+
+SCENARIO("Packed representation")
+{
+	GIVEN("A basic word")
+	{
+		Basic_word<5> bw{Sign::Minus, {1, 2, 3, 4, 5}};
+		WHEN("Rebuilt from its packed representation")
+		{
+			Basic_word<5> copy{Basic_word<5>::from_packed(bw.packed())};
+			THEN("The words are equal")
+			{
+				REQUIRE(copy == bw);
+				REQUIRE(copy.sign() == Sign::Minus);
+				require_bytes_are(copy, {1, 2, 3, 4, 5});
+			}
+		}
+		WHEN("Integers are checked as packed representations")
+		{
+			using Decimal = Basic_word<5, Decimal_byte>;
+			Basic_word<5> invalid{bw};
+			invalid.byte(3) = INVALID_BYTE;
+			invalid.sign() = Sign::Invalid;
+			const Decimal::Packed lane_99{Decimal{99}.packed()};
+			THEN("Only the packed words of the byte model are accepted")
+			{
+				REQUIRE(Basic_word<5>::is_packed(bw.packed()));
+				REQUIRE(Basic_word<5>::is_packed(invalid.packed()));
+				REQUIRE(!Basic_word<5>::is_packed(std::uint64_t{1} << 63));
+				REQUIRE(!Basic_word<2>::is_packed(bw.packed()));
+				REQUIRE(Decimal::is_packed(lane_99));
+				REQUIRE(!Decimal::is_packed(lane_99 + 1));
+			}
+		}
+		WHEN("A byte is too large to fit in a machine byte")
+		{
+			bw.byte(2) = Binary_byte::max + 1;
+			THEN("The byte is marked invalid, and so is the word")
+			{
+				REQUIRE(bw.byte(2) == INVALID_BYTE);
+				REQUIRE(bw.is_valid() == false);
+			}
+			bw.shift_right(1);
+			THEN("The invalid byte moves with the shift")
+			{
+				require_bytes_are(bw, {0, 1, INVALID_BYTE, 3, 4});
+			}
+		}
+	}
+}
+
+SCENARIO("Inserting fields")
+{
+	GIVEN("Two basic words")
+	{
+		Basic_word<5> bw{Sign::Plus, {1, 2, 3, 4, 5}};
+		Basic_word<5> src{Sign::Minus, {6, 7, 8, 9, 10}};
+		WHEN("Inserting into field (0:2)")
+		{
+			bw.insert_field(src, {0, 2});
+			THEN("The right-most bytes and the sign are written")
+			{
+				REQUIRE(bw.sign() == Sign::Minus);
+				require_bytes_are(bw, {9, 10, 3, 4, 5});
+			}
+		}
+		WHEN("Inserting into field (3:3)")
+		{
+			bw.insert_field(src, {3, 3});
+			THEN("Only the right-most byte is written")
+			{
+				REQUIRE(bw.sign() == Sign::Plus);
+				require_bytes_are(bw, {1, 2, 10, 4, 5});
+			}
+		}
+		WHEN("Inserting into field (0:0)")
+		{
+			bw.insert_field(src, {0, 0});
+			THEN("Only the sign is written")
+			{
+				REQUIRE(bw.sign() == Sign::Minus);
+				require_bytes_are(bw, {1, 2, 3, 4, 5});
+			}
+		}
+		WHEN("Inserting a right aligned field back")
+		{
+			Basic_word<5> aligned{src.field_aligned_right({1, 3})};
+			bw.insert_field(aligned, {1, 3});
+			THEN("The field is restored in place")
+			{
+				REQUIRE(bw.sign() == Sign::Plus);
+				require_bytes_are(bw, {6, 7, 8, 4, 5});
+			}
+		}
+		WHEN("Inserting into a field out of range")
+		{
+			THEN("An invalid argument exception is thrown")
+			{
+				REQUIRE_THROWS_AS(bw.insert_field(src, {1, 6}),
+								  std::invalid_argument);
+			}
+		}
+	}
+}
+
+SCENARIO("Basic words at compile time")
+{
+	GIVEN("A basic word built at compile time")
+	{
+		constexpr Basic_word<5> bw{Sign::Minus, {1, 2, 3, 4, 5}};
+		static_assert(bw.byte(3) == 3, "");
+		static_assert(bw.sign() == Sign::Minus, "");
+		static_assert(bw.to_int(Field_spec{1, 4}) == 270532, "");
+		static_assert(bw.field_aligned_right({0, 2}).to_int() == -66, "");
+		static_assert(Basic_word<5>{-2000}.to_int() == -2000, "");
+		THEN("It is the same as the word built at run time")
+		{
+			Basic_word<5> runtime{Sign::Minus, {1, 2, 3, 4, 5}};
+			REQUIRE(bw == runtime);
+		}
+	}
+}
+
+SCENARIO("Shifting a pair of words")
+{
+	GIVEN("A pair of words")
+	{
+		Basic_word<5> left{Sign::Minus, {1, 2, 3, 4, 5}};
+		Basic_word<5> right{Sign::Plus, {6, 7, 8, 9, 10}};
+		WHEN("Shifted left across both words")
+		{
+			Basic_word<5>::shift_pair_left(left, right, 3);
+			THEN("Bytes move from the right word into the left word")
+			{
+				REQUIRE(left.sign() == Sign::Minus);
+				require_bytes_are(left, {4, 5, 6, 7, 8});
+				REQUIRE(right.sign() == Sign::Plus);
+				require_bytes_are(right, {9, 10, 0, 0, 0});
+			}
+		}
+		WHEN("Shifted right by more than both words")
+		{
+			Basic_word<5>::shift_pair_right(left, right, 11);
+			THEN("All bytes are 0")
+			{
+				require_bytes_are(left, {0, 0, 0, 0, 0});
+				require_bytes_are(right, {0, 0, 0, 0, 0});
+			}
+		}
+		WHEN("Rotated right")
+		{
+			Basic_word<5>::rotate_pair_right(left, right, 12);
+			THEN("Bytes wrap around from the right word to the left word")
+			{
+				require_bytes_are(left, {9, 10, 1, 2, 3});
+				require_bytes_are(right, {4, 5, 6, 7, 8});
+			}
+		}
+		WHEN("Rotated left")
+		{
+			Basic_word<5>::rotate_pair_left(left, right, 1);
+			THEN("Bytes wrap around from the left word to the right word")
+			{
+				require_bytes_are(left, {2, 3, 4, 5, 6});
+				require_bytes_are(right, {7, 8, 9, 10, 1});
+			}
+		}
+		WHEN("A byte is invalid")
+		{
+			left.byte(5) = INVALID_BYTE;
+			Basic_word<5>::shift_pair_right(left, right, 5);
+			THEN("Its invalid flag moves with it")
+			{
+				REQUIRE(left.is_valid() == true);
+				REQUIRE(right.byte(5) == INVALID_BYTE);
+			}
+		}
+		WHEN("Shifted by a negative amount")
+		{
+			THEN("An invalid argument exception is thrown")
+			{
+				REQUIRE_THROWS_AS(
+					Basic_word<5>::shift_pair_left(left, right, -1),
+					std::invalid_argument);
+				REQUIRE_THROWS_AS(
+					Basic_word<5>::rotate_pair_right(left, right, -1),
+					std::invalid_argument);
+			}
+		}
+	}
+	GIVEN("A pair of decimal words")
+	{
+		Basic_word<5, Decimal_byte> left{Sign::Plus, {1, 2, 3, 4, 5}};
+		Basic_word<5, Decimal_byte> right{Sign::Plus, {6, 7, 8, 9, 99}};
+		WHEN("Rotated right")
+		{
+			Basic_word<5, Decimal_byte>::rotate_pair_right(left, right, 1);
+			THEN("The pair rotates as one integer")
+			{
+				require_bytes_are(left, {99, 1, 2, 3, 4});
+				require_bytes_are(right, {5, 6, 7, 8, 9});
+			}
+		}
+	}
+}
+
+SCENARIO("Decimal basic words")
+{
+	using Decimal_word = Basic_word<5, Decimal_byte>;
+	GIVEN("A decimal word built from an int")
+	{
+		Decimal_word bw{-123456789};
+		THEN("Each byte holds two decimal digits")
+		{
+			REQUIRE(bw.sign() == Sign::Minus);
+			require_bytes_are(bw, {1, 23, 45, 67, 89});
+			REQUIRE(bw.magnitude() == 123456789);
+			REQUIRE(bw.to_int() == -123456789);
+			REQUIRE(bw.to_int(Field_spec{0, 2}) == -123);
+			REQUIRE(bw.to_int(2, 3) == 2345);
+		}
+		WHEN("Shifted right")
+		{
+			bw.shift_right(2);
+			THEN("The value is divided by 10000")
+			{
+				REQUIRE(bw.to_int() == -12345);
+			}
+		}
+	}
+	GIVEN("A decimal word")
+	{
+		Decimal_word bw{};
+		WHEN("A byte above 99 is written")
+		{
+			bw.byte(3) = 100;
+			THEN("The word is invalid")
+			{
+				REQUIRE(bw.is_valid() == false);
+				REQUIRE(bw.byte(3) == INVALID_BYTE);
+			}
+		}
+		WHEN("A byte of 99 is written")
+		{
+			bw.byte(3) = 99;
+			THEN("The word is valid")
+			{
+				REQUIRE(bw.is_valid() == true);
+				REQUIRE(bw.to_int() == 990000);
+			}
+		}
+	}
+	GIVEN("The magnitude limits of a decimal word")
+	{
+		THEN("They are powers of ten")
+		{
+			static_assert(Decimal_word::modulus() == 10000000000, "");
+			static_assert(Basic_word<2, Decimal_byte>::int_max() == 9999, "");
+			static_assert(Decimal_word::from_magnitude(Sign::Plus, 4000)
+							  .to_int(Field_spec{4, 5}) == 4000, "");
+			REQUIRE(Decimal_word::from_magnitude(Sign::Plus, 10000000042)
+						.magnitude() == 42);
+		}
 	}
 }
@@ -0,0 +1,93 @@
+#include "catch.hpp"
+#include "../Decoder.h"
+#include "../Instruction.h"
+#include "../Op_code.h"
+#include "../Word.h"
+#include <vector>
+
+using namespace mix;
+
+SCENARIO("Decoding instructions by table")
+{
+	GIVEN("A valid indexed instruction with a negative address")
+	{
+		const Word word{encode({-300, 2, {1, 3}, 11, Op_code::LDX})};
+		WHEN("It is decoded")
+		{
+			const Decoded_instruction decoded{Decoder::decode(word)};
+			THEN("It matches the word decoder")
+			{
+				const Instruction expected{decode_unindexed(word)};
+				const Instruction inst{Decoder::to_instruction(decoded)};
+				REQUIRE(decoded.status == Decode_status::Valid);
+				REQUIRE(decoded.kind == Op_kind::Load);
+				REQUIRE(inst.address == expected.address);
+				REQUIRE(inst.index_spec == expected.index_spec);
+				REQUIRE(inst.field == expected.field);
+				REQUIRE(inst.modification == expected.modification);
+				REQUIRE(inst.op_code == expected.op_code);
+			}
+		}
+	}
+	GIVEN("A word whose field spec has its left part after its right part")
+	{
+		const Word word{Sign::Plus, {1, 36, 0, 5 * 8 + 1, Op_code::LDA}};
+		THEN("It decodes as an invalid field, without throwing")
+		{
+			const Decoded_instruction decoded{Decoder::decode(word)};
+			REQUIRE(decoded.status == Decode_status::Invalid_field);
+			REQUIRE(decoded.address == Word::byte_model::radix + 36);
+			REQUIRE((Decoder::field_spec(decoded) == Field_spec{0, 0}));
+		}
+	}
+	GIVEN("A word whose op code has no operation")
+	{
+		const Word word{Sign::Plus, {1, 36, 0, 5, 60}};
+		THEN("It decodes as an unknown op code")
+		{
+			const Decoded_instruction decoded{Decoder::decode(word)};
+			REQUIRE(decoded.status == Decode_status::Unknown_op_code);
+			REQUIRE(decoded.kind == Op_kind::Unknown);
+			REQUIRE(decoded.op_code == 60);
+		}
+	}
+	GIVEN("An invalid word")
+	{
+		const Word word{Sign::Invalid, {1, 36, 0, 5, Op_code::LDA}};
+		THEN("It decodes as an invalid word")
+		{
+			REQUIRE(Decoder::decode(word).status
+					== Decode_status::Invalid_word);
+		}
+	}
+	GIVEN("An image of every op code and field")
+	{
+		std::vector<Word> image{};
+		const int radix{Word::byte_model::radix};
+		for (int code = 0; code < radix; ++code)
+			for (int field = 0; field < radix; ++field)
+				image.push_back(Word{Sign::Minus, {1, 2, 3,
+					static_cast<Byte>(field), static_cast<Byte>(code)}});
+		WHEN("It is decoded in bulk")
+		{
+			std::vector<Decoded_instruction> decoded(image.size());
+			Decoder::decode(image.data(), image.data() + image.size(),
+							decoded.data());
+			THEN("Each word agrees with the word decoder")
+			{
+				for (std::size_t i = 0; i < image.size(); ++i) {
+					const Word& word{image[i]};
+					const bool decodable{is_decodable(word)};
+					REQUIRE((decoded[i].status
+							 != Decode_status::Invalid_field) == decodable);
+					REQUIRE(decoded[i].kind == op_kind(get_op_code(word)));
+					REQUIRE(decoded[i].address == get_address(word));
+					if (decodable) {
+						REQUIRE(Decoder::field_spec(decoded[i])
+								== get_field_spec(word));
+					}
+				}
+			}
+		}
+	}
+}
@@ -8,8 +8,8 @@ using namespace mix;
 /* Helper functions. */
 
 // Asserts all bytes in the given word match the given bytes.
-template<unsigned int N>
-void require_bytes_are(const Basic_word<N>& bw, std::vector<Byte> bytes)
+template<unsigned int N, typename M>
+void require_bytes_are(const Basic_word<N, M>& bw, std::vector<Byte> bytes)
 {
 	int i = 1;
 	for (auto p = bytes.begin(); p != bytes.end(); ++p)
@@ -17,8 +17,8 @@ void require_bytes_are(const Basic_word<N>& bw, std::vector<Byte> bytes)
 }
 
 // Asserts that all bytes match between the two basic words.
-template<unsigned int N>
-void require_bytes_match(const Basic_word<N>& a, const Basic_word<N>& b)
+template<unsigned int N, typename M>
+void require_bytes_match(const Basic_word<N, M>& a, const Basic_word<N, M>& b)
 {
 	for (int i = 1; i <= N; ++i)
 		REQUIRE(a.byte(i) == b.byte(i));
@@ -14,7 +14,7 @@ SCENARIO("Getting parts of an instruction")
 			int address{get_address(inst)};
 			THEN("The address is correct")
 			{
-				REQUIRE(address == 66);
+				REQUIRE(address == Word::byte_model::radix + 2);
 			}
 		}
 		WHEN("Getting the index specification")
@@ -44,3 +44,46 @@ SCENARIO("Getting parts of an instruction")
 		}
 	}
 }
+
+SCENARIO("Encoding an instruction")
+{
+	GIVEN("An instruction")
+	{
+		const Instruction inst{-2000, 3, {1, 3}, 11, Op_code::LDX};
+		WHEN("Encoded as a word")
+		{
+			const Word word{encode(inst)};
+			THEN("Each part of the instruction is in its byte")
+			{
+				REQUIRE(get_address(word) == -2000);
+				REQUIRE(get_index_spec(word) == 3);
+				REQUIRE(get_field_spec(word) == Field_spec(1, 3));
+				REQUIRE(get_op_code(word) == Op_code::LDX);
+			}
+		}
+		WHEN("The address doesn't fit in two bytes")
+		{
+			const int radix{Word::byte_model::radix};
+			const Instruction big{radix * radix, 0, {0, 5}, 5, Op_code::LDA};
+			THEN("An invalid argument exception is thrown")
+			{
+				REQUIRE_THROWS_AS(encode(big), std::invalid_argument);
+			}
+		}
+	}
+	GIVEN("A program built at compile time")
+	{
+		constexpr Word program[]{
+			encode({1, 0, {0, 5}, 5, Op_code::LDA}),
+			encode({2, 0, {0, 5}, 5, Op_code::STA})
+		};
+		static_assert(get_address(program[0]) == 1, "");
+		static_assert(get_op_code(program[1]) == Op_code::STA, "");
+		static_assert(get_field_spec(program[1]) == Field_spec(0, 5), "");
+		THEN("The words are the same as when encoded at run time")
+		{
+			REQUIRE(program[0] == Word(Sign::Plus, {0, 1, 0, 5, Op_code::LDA}));
+			REQUIRE(program[1] == Word(Sign::Plus, {0, 2, 0, 5, Op_code::STA}));
+		}
+	}
+}
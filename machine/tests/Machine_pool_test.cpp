@@ -0,0 +1,109 @@
+#include "catch.hpp"
+#include "../Machine.h"
+#include "../Machine_pool.h"
+#include "../Op_code.h"
+#include "../Word.h"
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace mix;
+
+namespace
+{
+	/*
+	* Load a program adding cells 100 and 101 into cell 102, then
+	* stopping at a cell without an operation.
+	* Parameters:
+	*	machine - Machine to load.
+	*/
+	void load_adder(Machine& machine)
+	{
+		std::stringstream program{};
+		program << encode({100, 0, {0, 5}, 5, Op_code::LDA})
+				<< encode({101, 0, {0, 5}, 5, Op_code::ADD})
+				<< encode({102, 0, {0, 5}, 5, Op_code::STA})
+				<< Word{};
+		machine.load_program(&program);
+	}
+
+	/*
+	* Run the adder on the given machine, ignoring the stop.
+	* Parameters:
+	*	machine - Machine with the adder loaded.
+	*	a, b - Numbers to add.
+	*/
+	void run_adder(Machine& machine, int a, int b)
+	{
+		machine.memory_cell(100, Word{a});
+		machine.memory_cell(101, Word{b});
+		try { machine.run_program(); } catch (std::invalid_argument&) {}
+	}
+}
+
+SCENARIO("Pooling machines")
+{
+	GIVEN("A pool of machines with a program loaded")
+	{
+		Machine_pool pool{2, Machine::Reset_mode::Keep_program, load_adder};
+		THEN("Its machines are built up front")
+		{
+			REQUIRE(pool.available() == 2);
+		}
+		WHEN("A machine is leased, run and handed back")
+		{
+			{
+				Machine_pool::Lease lease{pool.acquire()};
+				REQUIRE(pool.available() == 1);
+				run_adder(*lease, 20, 22);
+				REQUIRE(lease->memory_cell(102) == Word{42});
+			}
+			THEN("It comes back reset, with its program")
+			{
+				REQUIRE(pool.available() == 2);
+				Machine_pool::Lease first{pool.acquire()};
+				Machine_pool::Lease second{pool.acquire()};
+				for (Machine* machine : {&*first, &*second}) {
+					REQUIRE(machine->accumulator() == Word{});
+					REQUIRE(machine->memory_cell(102) == Word{});
+					REQUIRE(machine->memory_cell(1)
+							== encode({101, 0, {0, 5}, 5, Op_code::ADD}));
+				}
+			}
+		}
+		WHEN("More machines are leased than the pool holds")
+		{
+			Machine_pool::Lease first{pool.acquire()};
+			Machine_pool::Lease second{pool.acquire()};
+			Machine_pool::Lease third{pool.acquire()};
+			THEN("The pool grows, with prepared machines")
+			{
+				run_adder(*third, 1, 2);
+				REQUIRE(third->memory_cell(102) == Word{3});
+			}
+		}
+		WHEN("Many threads lease machines at once")
+		{
+			std::atomic<int> wrong{0};
+			std::vector<std::thread> threads{};
+			for (int t = 0; t < 4; ++t) {
+				threads.emplace_back([&pool, &wrong, t] {
+					for (int i = 0; i < 50; ++i) {
+						Machine_pool::Lease lease{pool.acquire()};
+						run_adder(*lease, t, i);
+						if (!(lease->memory_cell(102) == Word{t + i}))
+							++wrong;
+					}
+				});
+			}
+			for (std::thread& thread : threads)
+				thread.join();
+			THEN("Each run sees its own machine")
+			{
+				REQUIRE(wrong == 0);
+				REQUIRE(2 <= pool.available());
+			}
+		}
+	}
+}
@@ -1,10 +1,22 @@
 #include "catch.hpp"
 #include "Helpers.h"
+#include "../Jit.h"
 #include "../Machine.h"
 #include "../Op_code.h"
+#include "../Op_specializations.h"
+#include "../Op_table.h"
+#include "../Program_image.h"
+#include "../Snapshot.h"
+#include "../Superinstructions.h"
 #include "../Word.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <fstream>
+#include <iterator>
+#include <memory>
 #include <sstream>
+#include <string>
 #include <vector>
 
 using namespace mix;
@@ -71,6 +83,27 @@ SCENARIO("Accessing memory")
 				require_bytes_are(w2, {0, 0, 0, 0, 0});
 			}
 		}
+		WHEN("Storing into a field of a cell")
+		{
+			machine.memory_cell(10, {Sign::Minus, {1, 2, 3, 4, 5}});
+			machine.store_field(10, {Sign::Plus, {6, 7, 8, 9, 10}}, {4, 5});
+			THEN("Only the field is written, in place")
+			{
+				const Word w{machine.memory_cell(10)};
+				REQUIRE(w.sign() == Sign::Minus);
+				require_bytes_are(w, {1, 2, 3, 9, 10});
+			}
+		}
+		WHEN("Updating the accumulator by reference")
+		{
+			machine.accumulator_ref() = Word{Sign::Minus, {1, 2, 3, 4, 5}};
+			machine.extension_register_ref().negate();
+			THEN("The registers read back the update")
+			{
+				require_bytes_are(machine.accumulator(), {1, 2, 3, 4, 5});
+				REQUIRE(machine.extension_register().sign() == Sign::Minus);
+			}
+		}
 	}
 }
 
@@ -92,6 +125,203 @@ SCENARIO("Program counter")
 	}
 }
 
+SCENARIO("Running a program")
+{
+	GIVEN("A program that adds two numbers, stores and shifts the sum")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(1, encode({101, 0, {0, 5}, 5, Op_code::ADD}));
+		machine.memory_cell(2, encode({102, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(3, encode({1, 0, {0, 3}, 3, Op_code::SFT}));
+		machine.memory_cell(100, Word{1000});
+		machine.memory_cell(101, Word{-1});
+		WHEN("The program runs to the first cell without an operation")
+		{
+			if (CHECKED_ACCESS) {
+				REQUIRE_THROWS_AS(machine.run_program(),
+								  std::invalid_argument);
+			}
+			else {
+				machine.run_program();
+				REQUIRE(machine.fault() == Machine::Fault::Op_code);
+			}
+			THEN("Every instruction was executed, then it stopped")
+			{
+				REQUIRE(machine.memory_cell(102) == Word{999});
+				REQUIRE(machine.accumulator()
+						== Word{999 / Word::byte_model::radix});
+				REQUIRE(machine.program_counter() == 5);
+			}
+		}
+		WHEN("The program is changed and runs again")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			machine.memory_cell(1, encode({101, 0, {0, 5}, 5, Op_code::SUB}));
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("The changed program is executed")
+			{
+				REQUIRE(machine.memory_cell(102) == Word{1001});
+			}
+		}
+	}
+}
+
+SCENARIO("Self-modifying code")
+{
+	GIVEN("A mix machine that has executed an instruction")
+	{
+		Machine machine{};
+		machine.memory_cell(100, {Sign::Minus, {1, 2, 3, 4, 5}});
+		machine.memory_cell(1, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.program_counter(1);
+		machine.execute_next_instruction();
+		WHEN("The instruction is rewritten through memory_cell")
+		{
+			machine.memory_cell(1, encode({100, 0, {0, 5}, 5, Op_code::LDX}));
+			machine.program_counter(1);
+			machine.execute_next_instruction();
+			THEN("The new instruction is executed")
+			{
+				REQUIRE(machine.extension_register()
+						== machine.memory_cell(100));
+			}
+		}
+		WHEN("The instruction is rewritten by a store instruction")
+		{
+			machine.accumulator(encode({100, 0, {0, 5}, 5, Op_code::LDX}));
+			machine.memory_cell(0, encode({1, 0, {0, 5}, 5, Op_code::STA}));
+			machine.program_counter(0);
+			machine.execute_next_instruction();
+			machine.execute_next_instruction();
+			THEN("The new instruction is executed")
+			{
+				REQUIRE(machine.extension_register()
+						== machine.memory_cell(100));
+			}
+		}
+	}
+	GIVEN("A mix machine with an indexed instruction")
+	{
+		Machine machine{};
+		machine.memory_cell(100, {Sign::Plus, {1, 1, 1, 1, 1}});
+		machine.memory_cell(101, {Sign::Plus, {2, 2, 2, 2, 2}});
+		machine.memory_cell(0, encode({100, 1, {0, 5}, 5, Op_code::LDA}));
+		machine.program_counter(0);
+		machine.execute_next_instruction();
+		WHEN("The index register changes between executions")
+		{
+			machine.index_register(1, {Sign::Plus, {0, 1}});
+			machine.program_counter(0);
+			machine.execute_next_instruction();
+			THEN("The address is offset by the current index")
+			{
+				REQUIRE(machine.accumulator() == machine.memory_cell(101));
+			}
+		}
+	}
+}
+
+SCENARIO("Resetting the machine")
+{
+	GIVEN("A machine that has run a program")
+	{
+		Machine machine{};
+		std::stringstream program{};
+		program << encode({100, 0, {0, 5}, 5, Op_code::LDA})
+				<< encode({101, 0, {0, 5}, 5, Op_code::STA})
+				<< Word{};
+		machine.load_program(&program);
+		machine.memory_cell(100, Word{-7});
+		machine.index_register(3, Half_word{5});
+		machine.overflow_bit(Machine::Bit::On);
+		try { machine.run_program(); } catch (std::invalid_argument&) {}
+		WHEN("It is reset to its power-on state")
+		{
+			machine.reset();
+			THEN("Registers, flags and memory are cleared")
+			{
+				Machine blank{};
+				REQUIRE(machine.program_counter() == 0);
+				REQUIRE(machine.overflow_bit() == Machine::Bit::Off);
+				REQUIRE(machine.fault() == Machine::Fault::None);
+				REQUIRE(machine.accumulator() == Word{});
+				REQUIRE(machine.index_register(3) == Half_word{});
+				REQUIRE(machine.first_memory_difference(blank)
+						== Machine::mem_size);
+			}
+		}
+		WHEN("It is reset keeping its program")
+		{
+			machine.reset(Machine::Reset_mode::Keep_program);
+			THEN("Only the loaded program is left in memory")
+			{
+				REQUIRE(machine.accumulator() == Word{});
+				REQUIRE(machine.memory_cell(0)
+						== encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+				REQUIRE(machine.memory_cell(100) == Word{});
+				REQUIRE(machine.memory_cell(101) == Word{});
+			}
+			AND_WHEN("The program runs again")
+			{
+				machine.memory_cell(100, Word{9});
+				try { machine.run_program(); } catch (std::invalid_argument&) {}
+				THEN("It runs as if freshly loaded")
+				{
+					REQUIRE(machine.memory_cell(101) == Word{9});
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Cloning the machine")
+{
+	GIVEN("A machine part way through a program")
+	{
+		Machine machine{};
+		std::stringstream program{};
+		program << encode({100, 0, {0, 5}, 5, Op_code::LDA})
+				<< encode({101, 0, {0, 5}, 5, Op_code::ADD})
+				<< encode({102, 0, {0, 5}, 5, Op_code::STA})
+				<< Word{};
+		machine.load_program(&program);
+		machine.memory_cell(100, Word{40});
+		machine.memory_cell(101, Word{2});
+		machine.execute_next_instruction();
+		WHEN("It is cloned, and each machine continues differently")
+		{
+			const std::unique_ptr<Machine> clone{machine.clone()};
+			clone->memory_cell(101, Word{-2});
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			clone->execute_next_instruction();
+			clone->execute_next_instruction();
+			THEN("The clone started from the state of the original")
+			{
+				REQUIRE(clone->program_counter() == 3);
+				REQUIRE(clone->accumulator() == Word{38});
+				REQUIRE(clone->memory_cell(102) == Word{38});
+			}
+			THEN("The original doesn't see the writes of its clone")
+			{
+				REQUIRE(machine.memory_cell(101) == Word{2});
+				REQUIRE(machine.memory_cell(102) == Word{42});
+				REQUIRE(machine.first_memory_difference(*clone) == 101);
+			}
+			AND_WHEN("The clone is reset keeping its program")
+			{
+				clone->reset(Machine::Reset_mode::Keep_program);
+				THEN("It has the program of the original")
+				{
+					REQUIRE(clone->memory_cell(2)
+							== encode({102, 0, {0, 5}, 5, Op_code::STA}));
+					REQUIRE(clone->memory_cell(101) == Word{});
+				}
+			}
+		}
+	}
+}
+
 SCENARIO("Loading memory")
 {
 	GIVEN("A mix machine and a word to load")
@@ -111,6 +341,273 @@ SCENARIO("Loading memory")
 	}
 }
 
+SCENARIO("Comparing memory between machines")
+{
+	GIVEN("Two mix machines")
+	{
+		Machine first{};
+		Machine second{};
+		THEN("Their memories don't differ")
+		{
+			REQUIRE(first.first_memory_difference(second) == Machine::mem_size);
+		}
+		WHEN("A cell of one machine is changed")
+		{
+			second.memory_cell(1000, Word{Sign::Minus});
+			THEN("The difference is found at that address")
+			{
+				REQUIRE(first.first_memory_difference(second) == 1000);
+				REQUIRE(first.first_memory_difference(second, 1001)
+						== Machine::mem_size);
+			}
+		}
+	}
+}
+
+SCENARIO("Exporting and importing memory")
+{
+	GIVEN("A mix machine with words in memory")
+	{
+		Machine machine{};
+		machine.memory_cell(0, Word{-5});
+		machine.memory_cell(3999, Word{Word::int_max()});
+		WHEN("Memory is exported")
+		{
+			std::vector<long long> values(Machine::mem_size);
+			machine.export_memory(values.data());
+			THEN("Each value is the integer value of its cell")
+			{
+				REQUIRE(values[0] == -5);
+				REQUIRE(values[1] == 0);
+				REQUIRE(values[3999] == Word::int_max());
+			}
+			AND_WHEN("An image with a value too big for a word is imported")
+			{
+				machine.memory_cell(1, encode({3999, 0, {0, 5}, 5,
+											   Op_code::LDA}));
+				machine.program_counter(1);
+				machine.execute_next_instruction();
+				values[1] = Word::int_max();
+				values[3999] = Word::int_max() + 1;
+				THEN("It throws, and memory and its decoding are unchanged")
+				{
+					REQUIRE_THROWS_AS(machine.import_memory(values.data()),
+									  std::invalid_argument);
+					REQUIRE(machine.memory_cell(0) == Word{-5});
+					machine.accumulator(Word{});
+					machine.program_counter(1);
+					machine.execute_next_instruction();
+					REQUIRE(machine.accumulator() == Word{Word::int_max()});
+				}
+			}
+			AND_WHEN("Imported into another machine")
+			{
+				Machine copy{};
+				copy.import_memory(values.data());
+				THEN("Both memories are the same")
+				{
+					REQUIRE(machine.first_memory_difference(copy)
+							== Machine::mem_size);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Saving and restoring snapshots")
+{
+	GIVEN("A mix machine with state in every register and in memory")
+	{
+		const std::string path{"machine_test.snapshot"};
+		Machine machine{};
+		machine.program_counter(17);
+		machine.accumulator(Word{Sign::Minus, {1, 2, 3, 4, 5}});
+		machine.extension_register(Word{-77});
+		machine.jump_register(Half_word{12});
+		for (int i = 1; i <= Machine::num_index_registers; ++i)
+			machine.index_register(i, Half_word{-i});
+		machine.overflow_bit(Machine::Bit::On);
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(3999, Word{Sign::Minus});
+		WHEN("A snapshot is saved, and restored into another machine")
+		{
+			machine.save_snapshot(path);
+			Machine restored{};
+			restored.memory_cell(10, Word{10});
+			restored.restore_snapshot(path);
+			THEN("Both machines have the same state")
+			{
+				REQUIRE(restored.program_counter() == 17);
+				REQUIRE(restored.accumulator() == machine.accumulator());
+				REQUIRE(restored.extension_register() == Word{-77});
+				REQUIRE(restored.jump_register() == Half_word{12});
+				REQUIRE(restored.index_register(6) == Half_word{-6});
+				REQUIRE(restored.overflow_bit() == Machine::Bit::On);
+				REQUIRE(restored.comparison_indicator()
+						== Machine::Comparison_value::Equal);
+				REQUIRE(restored.first_memory_difference(machine)
+						== Machine::mem_size);
+			}
+			AND_WHEN("The restored machine runs")
+			{
+				restored.memory_cell(100, Word{5});
+				restored.program_counter(0);
+				restored.execute_next_instruction();
+				THEN("It runs the restored memory")
+				{
+					REQUIRE(restored.accumulator() == Word{5});
+				}
+			}
+		}
+		WHEN("A snapshot is saved after a fault at the last cell")
+		{
+			machine.program_counter(Machine::mem_size - 1);
+			if (CHECKED_ACCESS) {
+				REQUIRE_THROWS_AS(machine.execute_next_instruction(),
+								  std::invalid_argument);
+			}
+			else {
+				machine.execute_next_instruction();
+			}
+			machine.save_snapshot(path);
+			Machine restored{};
+			restored.restore_snapshot(path);
+			THEN("The program counter one past memory is restored")
+			{
+				REQUIRE(machine.program_counter() == Machine::mem_size);
+				REQUIRE(restored.program_counter() == Machine::mem_size);
+			}
+			AND_WHEN("The restored machine resumes")
+			{
+				THEN("It traps fetching outside memory")
+				{
+					if (CHECKED_ACCESS) {
+						REQUIRE_THROWS_AS(restored.execute_next_instruction(),
+										  std::invalid_argument);
+					}
+					else {
+						restored.execute_next_instruction();
+						REQUIRE(restored.fault()
+								== Machine::Fault::Op_code);
+					}
+				}
+			}
+		}
+		WHEN("A snapshot is saved over another one")
+		{
+			machine.save_snapshot(path);
+			Machine other{};
+			other.accumulator(Word{42});
+			other.save_snapshot(path);
+			machine.restore_snapshot(path);
+			THEN("The last snapshot saved is restored")
+			{
+				REQUIRE(machine.accumulator() == Word{42});
+				REQUIRE(machine.program_counter() == 0);
+				REQUIRE(machine.memory_cell(0) == Word{});
+			}
+		}
+		WHEN("A snapshot can't be saved")
+		{
+			THEN("An exception is thrown")
+			{
+				REQUIRE_THROWS_AS(
+					machine.save_snapshot("no_such_directory/a.snapshot"),
+					std::runtime_error);
+			}
+		}
+		WHEN("A snapshot with invalid contents is restored")
+		{
+			machine.save_snapshot(path);
+			std::string bytes{};
+			{
+				std::ifstream file{path, std::ios::binary};
+				bytes.assign(std::istreambuf_iterator<char>{file}, {});
+			}
+			Machine restored{};
+			const auto restore_with = [&](std::size_t offset,
+										  const void* value,
+										  std::size_t size) {
+				std::string corrupt{bytes};
+				corrupt.replace(offset, size,
+								static_cast<const char*>(value), size);
+				{
+					std::ofstream file{path, std::ios::binary};
+					file.write(corrupt.data(), corrupt.size());
+				}
+				restored.restore_snapshot(path);
+			};
+			const Word::Packed stray_bit{Word::Packed{1} << 63};
+			const std::int32_t past_memory{Machine::mem_size + 1};
+			const std::int32_t before_memory{-1};
+			THEN("An exception is thrown, and the machine is unchanged")
+			{
+				REQUIRE_THROWS_AS(
+					restore_with(offsetof(Snapshot::Header, pc),
+								 &past_memory, sizeof(past_memory)),
+					std::invalid_argument);
+				REQUIRE_THROWS_AS(
+					restore_with(offsetof(Snapshot::Header, pc),
+								 &before_memory, sizeof(before_memory)),
+					std::invalid_argument);
+				REQUIRE_THROWS_AS(
+					restore_with(offsetof(Snapshot::Header, jump),
+								 &stray_bit, sizeof(stray_bit)),
+					std::invalid_argument);
+				REQUIRE_THROWS_AS(
+					restore_with(Snapshot::size(3999),
+								 &stray_bit, sizeof(stray_bit)),
+					std::invalid_argument);
+				REQUIRE(restored.first_memory_difference(Machine{})
+						== Machine::mem_size);
+				REQUIRE(restored.program_counter() == 0);
+			}
+		}
+		WHEN("A file that isn't a snapshot is restored")
+		{
+			{
+				std::ofstream file{path, std::ios::binary};
+				file << "Not a snapshot, but long enough to hold a header, "
+					 << "which it would have, were it a snapshot at all.";
+			}
+			THEN("An exception is thrown, and the machine is unchanged")
+			{
+				REQUIRE_THROWS_AS(machine.restore_snapshot(path),
+								  std::invalid_argument);
+				REQUIRE(machine.program_counter() == 17);
+			}
+		}
+		WHEN("A truncated snapshot is restored")
+		{
+			machine.save_snapshot(path);
+			std::string bytes{};
+			{
+				std::ifstream file{path, std::ios::binary};
+				bytes.assign(std::istreambuf_iterator<char>{file}, {});
+			}
+			{
+				std::ofstream file{path, std::ios::binary};
+				file.write(bytes.data(), bytes.size() / 2);
+			}
+			THEN("An exception is thrown")
+			{
+				REQUIRE_THROWS_AS(machine.restore_snapshot(path),
+								  std::invalid_argument);
+			}
+		}
+		WHEN("A missing snapshot is restored")
+		{
+			THEN("An exception is thrown")
+			{
+				REQUIRE_THROWS_AS(
+					machine.restore_snapshot("no_such_machine.snapshot"),
+					std::runtime_error);
+			}
+		}
+		std::remove(path.c_str());
+	}
+}
+
 SCENARIO("Dumping memory", "[A]")
 {
 	GIVEN("A mix machine")
@@ -168,6 +665,20 @@ SCENARIO("Loading a program")
 				require_bytes_are(w, {6, 7, 8, 9, 0});
 			}
 		}
+		WHEN("A program is loaded over a memory holding data")
+		{
+			machine.memory_cell(1, Word{5});
+			machine.memory_cell(500, Word{5});
+			std::stringstream ss{};
+			ss << Word{Sign::Plus, {1, 2, 3, 4, 5}};
+			machine.load_program(&ss);
+			THEN("The cells after the program are cleared")
+			{
+				require_bytes_are(machine.memory_cell(0), {1, 2, 3, 4, 5});
+				REQUIRE(machine.memory_cell(1) == Word{});
+				REQUIRE(machine.memory_cell(500) == Word{});
+			}
+		}
 		WHEN("A program file cannot be opened")
 		{
 			std::ifstream program{"file_that_doesnt_exist"};
@@ -186,6 +697,17 @@ SCENARIO("Loading a program")
 								  std::invalid_argument);
 			}
 		}
+		WHEN("A program larger than memory is loaded")
+		{
+			std::stringstream ss{};
+			for (int i = 0; i <= Machine::mem_size; ++i)
+				ss << Word{};
+			THEN("An invalid argument exception is thrown")
+			{
+				REQUIRE_THROWS_AS(machine.load_program(&ss),
+								  std::invalid_argument);
+			}
+		}
 		WHEN("An invalid program is loaded")
 		{
 			std::stringstream ss{};
@@ -200,6 +722,51 @@ SCENARIO("Loading a program")
 	}
 }
 
+SCENARIO("Sharing a program image")
+{
+	GIVEN("A program image loaded by two machines")
+	{
+		std::stringstream program{};
+		program << encode({100, 0, {0, 5}, 5, Op_code::LDA})
+				<< encode({1, 0, {0, 5}, 5, Op_code::STA})
+				<< Word{};
+		const Program_image image{&program};
+		Machine first{};
+		Machine second{};
+		first.memory_cell(500, Word{5});
+		first.load_program(image);
+		second.load_program(image);
+		THEN("Both machines hold the program, and nothing else")
+		{
+			// The cell written before loading is cleared.
+			REQUIRE(image.size() == 3);
+			REQUIRE(first.memory_cell(500) == Word{});
+			REQUIRE(first.first_memory_difference(second)
+					== Machine::mem_size);
+		}
+		WHEN("One machine writes over its program")
+		{
+			first.memory_cell(100, encode({7, 0, {0, 5}, 5, Op_code::LDX}));
+			try { first.run_program(); } catch (std::invalid_argument&) {}
+			THEN("The image and the other machine are unchanged")
+			{
+				REQUIRE(first.memory_cell(1) == first.memory_cell(100));
+				REQUIRE(image[1] == encode({1, 0, {0, 5}, 5, Op_code::STA}));
+				REQUIRE(second.memory_cell(1) == image[1]);
+			}
+			AND_WHEN("It is reset keeping its program")
+			{
+				first.reset(Machine::Reset_mode::Keep_program);
+				THEN("It holds the image again")
+				{
+					REQUIRE(first.first_memory_difference(second)
+							== Machine::mem_size);
+				}
+			}
+		}
+	}
+}
+
 SCENARIO("Loading index register")
 {
 	GIVEN("A mix machine and a half word to load")
@@ -239,7 +806,8 @@ SCENARIO("Reading the address from an instruction")
 		Machine machine{};
 		WHEN("Reading address from an instruction")
 		{
-			Word inst{Sign::Plus, {0x1f, 0x10, 1, 0, 0}};
+			const int radix{Word::byte_model::radix};
+			Word inst{Sign::Plus, {2000 / radix, 2000 % radix, 1, 0, 0}};
 			Half_word i1{Sign::Plus, {0, 1}};
 			machine.index_register(1, i1);
 			int address{machine.read_address(inst)};
@@ -459,12 +1027,12 @@ SCENARIO("Addition")
 		machine.memory_cell(0, inst);
 		WHEN("Adding field (0:5) of memory cell 1")
 		{
-			const int accum_before{machine.accumulator().to_int()};
+			const long long accum_before{machine.accumulator().to_int()};
 			machine.execute_next_instruction();
 			THEN("The accumulator contains result of addition")
 			{
 				const Word accum{machine.accumulator()};
-				const int mem{machine.memory_cell(1).to_int()};
+				const long long mem{machine.memory_cell(1).to_int()};
 				REQUIRE(accum.sign() == Sign::Plus);
 				REQUIRE(accum.to_int() == (accum_before + mem));
 			}
@@ -475,9 +1043,10 @@ SCENARIO("Addition")
 			machine.execute_next_instruction();
 			THEN("The accumulator contains remainder, and overflow is on")
 			{
+				// int_max + x wraps around to x - 1.
 				const Word accum{machine.accumulator()};
 				REQUIRE(accum.sign() == Sign::Plus);
-				require_bytes_are(accum, {1, 2, 3, 4, 5});
+				require_bytes_are(accum, {1, 2, 3, 4, 4});
 				REQUIRE(machine.overflow_bit() == Machine::Bit::On);
 			}
 		}
@@ -495,12 +1064,12 @@ SCENARIO("Subtraction")
 		machine.memory_cell(0, inst);
 		WHEN("Subtracting field (0:5) of memory cell 1")
 		{
-			const int accum_before{machine.accumulator().to_int()};
+			const long long accum_before{machine.accumulator().to_int()};
 			machine.execute_next_instruction();
 			THEN("The accumulator contains the result of subtraction")
 			{
 				const Word accum{machine.accumulator()};
-				const int mem{machine.memory_cell(1).to_int()};
+				const long long mem{machine.memory_cell(1).to_int()};
 				REQUIRE(accum.sign() == Sign::Plus);
 				REQUIRE(accum.to_int() == (accum_before - mem));
 			}
@@ -511,10 +1080,732 @@ SCENARIO("Subtraction")
 			machine.execute_next_instruction();
 			THEN("The accumulator contains remainder, and overflow is on")
 			{
+				// int_min - x wraps around to -(x - 1).
 				const Word accum{machine.accumulator()};
 				REQUIRE(accum.sign() == Sign::Minus);
-				require_bytes_are(accum, {1, 2, 3, 4, 5});
+				require_bytes_are(accum, {1, 2, 3, 4, 4});
+				REQUIRE(machine.overflow_bit() == Machine::Bit::On);
+			}
+		}
+	}
+}
+
+SCENARIO("Multiplication")
+{
+	GIVEN("A mix machine with some data in memory cell 1 and accumulator")
+	{
+		Machine machine{};
+		machine.memory_cell(1, {Sign::Minus, {0, 0, 0, 0, 2}});
+		machine.accumulator({Sign::Plus, {1, 1, 1, 1, 1}});
+		const Word inst{Sign::Plus, {0, 1, 0, 5, Op_code::MUL}};
+		machine.memory_cell(0, inst);
+		WHEN("Multiplying by field (0:5) of memory cell 1")
+		{
+			machine.execute_next_instruction();
+			THEN("The product is in rA:rX, both with the product's sign")
+			{
+				const Word accum{machine.accumulator()};
+				const Word exten{machine.extension_register()};
+				REQUIRE(accum.sign() == Sign::Minus);
+				require_bytes_are(accum, {0, 0, 0, 0, 0});
+				REQUIRE(exten.sign() == Sign::Minus);
+				require_bytes_are(exten, {2, 2, 2, 2, 2});
+			}
+		}
+		WHEN("The product doesn't fit in rA alone")
+		{
+			machine.accumulator({Word::int_max()});
+			machine.memory_cell(1, {Sign::Plus, {0, 0, 0, 1, 0}});
+			machine.execute_next_instruction();
+			THEN("The high bytes are in rA, the low bytes in rX")
+			{
+				const int top{Word::byte_model::radix - 1};
+				require_bytes_are(machine.accumulator(), {0, 0, 0, 0, top});
+				require_bytes_are(machine.extension_register(),
+								  {top, top, top, top, 0});
+				REQUIRE(machine.overflow_bit() == Machine::Bit::Off);
+			}
+		}
+	}
+}
+
+SCENARIO("Shifting")
+{
+	GIVEN("A mix machine with words in rA and rX")
+	{
+		Machine machine{};
+		machine.accumulator({Sign::Plus, {1, 2, 3, 4, 5}});
+		machine.extension_register({Sign::Minus, {6, 7, 8, 9, 10}});
+		machine.memory_cell(0, {Sign::Plus, {0, 1, 0, 3, Op_code::SFT}});
+		machine.memory_cell(1, {Sign::Plus, {0, 2, 0, 0, Op_code::SFT}});
+		machine.memory_cell(2, {Sign::Plus, {0, 4, 0, 5, Op_code::SFT}});
+		machine.memory_cell(3, {Sign::Plus, {0, 2, 0, 1, Op_code::SFT}});
+		const int radix{Word::byte_model::radix};
+		machine.memory_cell(4, {Sign::Plus,
+							   {501 / radix, 501 % radix, 0, 4, Op_code::SFT}});
+		WHEN("SRAX 1")
+		{
+			machine.execute_next_instruction();
+			THEN("rA:rX is shifted right one byte, signs unchanged")
+			{
+				REQUIRE(machine.accumulator().sign() == Sign::Plus);
+				require_bytes_are(machine.accumulator(), {0, 1, 2, 3, 4});
+				REQUIRE(machine.extension_register().sign() == Sign::Minus);
+				require_bytes_are(machine.extension_register(),
+								  {5, 6, 7, 8, 9});
+			}
+			AND_WHEN("SLA 2, SRC 4, SRA 2, SLC 501")
+			{
+				machine.execute_next_instruction();
+				const Word after_sla{machine.accumulator()};
+				machine.execute_next_instruction();
+				const Word after_src_a{machine.accumulator()};
+				const Word after_src_x{machine.extension_register()};
+				machine.execute_next_instruction();
+				const Word after_sra{machine.accumulator()};
+				machine.execute_next_instruction();
+				THEN("Each step shifts as in the mix examples")
+				{
+					require_bytes_are(after_sla, {2, 3, 4, 0, 0});
+					require_bytes_are(after_src_a, {6, 7, 8, 9, 2});
+					require_bytes_are(after_src_x, {3, 4, 0, 0, 5});
+					require_bytes_are(after_sra, {0, 0, 6, 7, 8});
+					require_bytes_are(machine.accumulator(),
+									  {0, 6, 7, 8, 3});
+					require_bytes_are(machine.extension_register(),
+									  {4, 0, 0, 5, 0});
+					REQUIRE(machine.extension_register().sign()
+							== Sign::Minus);
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Division")
+{
+	GIVEN("A mix machine with a dividend in rA:rX")
+	{
+		Machine machine{};
+		machine.accumulator({Sign::Minus, {0, 0, 0, 0, 1}});
+		machine.extension_register({Sign::Plus, {0, 0, 0, 0, 7}});
+		const Word inst{Sign::Plus, {0, 1, 0, 5, Op_code::DIV}};
+		machine.memory_cell(0, inst);
+		WHEN("Dividing by field (0:5) of memory cell 1")
+		{
+			machine.memory_cell(1, {Sign::Plus, {0, 0, 0, 0, 2}});
+			machine.execute_next_instruction();
+			THEN("rA holds the quotient, rX the remainder")
+			{
+				// (radix^5 + 7) / 2, signs from the division and dividend.
+				const Word accum{machine.accumulator()};
+				const Word exten{machine.extension_register()};
+				REQUIRE(accum.sign() == Sign::Minus);
+				const Byte half{Word::byte_model::radix / 2};
+				require_bytes_are(accum, {half, 0, 0, 0, 3});
+				REQUIRE(exten.sign() == Sign::Minus);
+				require_bytes_are(exten, {0, 0, 0, 0, 1});
+			}
+		}
+		WHEN("Dividing by zero")
+		{
+			machine.execute_next_instruction();
+			THEN("Overflow is on, and rA:rX are unchanged")
+			{
 				REQUIRE(machine.overflow_bit() == Machine::Bit::On);
+				require_bytes_are(machine.accumulator(), {0, 0, 0, 0, 1});
+				require_bytes_are(machine.extension_register(),
+								  {0, 0, 0, 0, 7});
+			}
+		}
+	}
+}
+
+SCENARIO("Specialized loads and stores")
+{
+	GIVEN("Loads and stores of common and other fields")
+	{
+		const Field_spec fields[]{{0, 5}, {1, 5}, {0, 2}, {4, 5}, {5, 5},
+								  {1, 3}, {0, 0}};
+		const int num_common_fields{5};
+		THEN("Common fields of loads and stores have specialized handlers")
+		{
+			for (int code = Op_code::ADD; code <= Op_code::STZ; ++code) {
+				const Op_code op{static_cast<Op_code>(code)};
+				for (int f = 0; f < 7; ++f) {
+					const Instruction inst{100, 0, fields[f], 0, op};
+					const bool expected{
+						(is_load_op(op) || is_store_op(op))
+						&& f < num_common_fields
+					};
+					REQUIRE((Op_specializations::find(inst) != NO_HANDLER)
+							== expected);
+				}
+			}
+		}
+		THEN("Specialized handlers execute as the generic operations")
+		{
+			for (int code = Op_code::LDA; code <= Op_code::STZ; ++code) {
+				for (int f = 0; f < num_common_fields; ++f) {
+					for (int index_spec = 0; index_spec <= 2; ++index_spec) {
+						const Instruction inst{
+							100, index_spec, fields[f], 0,
+							static_cast<Op_code>(code)
+						};
+						const Byte specialized{Op_specializations::find(inst)};
+						if (specialized == NO_HANDLER)
+							continue;
+
+						Machine machine{}, generic{};
+						for (Machine* m : {&machine, &generic}) {
+							m->accumulator({Sign::Minus, {1, 2, 3, 4, 5}});
+							m->extension_register({Sign::Plus,
+												   {6, 7, 8, 9, 10}});
+							m->jump_register({Sign::Plus, {11, 12}});
+							m->index_register(1, {Sign::Plus, {0, 1}});
+							m->index_register(2, {Sign::Minus, {0, 1}});
+							m->memory_cell(99, {Sign::Minus,
+												{13, 14, 15, 16, 17}});
+							m->memory_cell(100, {Sign::Plus,
+												 {18, 19, 20, 21, 22}});
+							m->memory_cell(101, {Sign::Minus,
+												 {23, 24, 25, 26, 27}});
+						}
+						Op_specializations::handler(specialized)(
+							&machine,
+							make_predecoded(inst, specialized,
+											Op_kind::Specialized));
+						Instruction indexed{inst};
+						if (index_spec == 1)
+							indexed.address += 1;
+						else if (index_spec == 2)
+							indexed.address -= 1;
+						Op_table::handler(inst.op_code)(&generic, indexed);
+
+						REQUIRE(machine.accumulator() == generic.accumulator());
+						REQUIRE(machine.extension_register()
+								== generic.extension_register());
+						for (int i = 1; i <= 6; ++i) {
+							REQUIRE(machine.index_register(i)
+									== generic.index_register(i));
+						}
+						REQUIRE(machine.first_memory_difference(generic)
+								== Machine::mem_size);
+					}
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Packing predecoded instructions")
+{
+	GIVEN("An indexed instruction with a negative address")
+	{
+		const Instruction inst{-300, 2, {1, 3}, 11, Op_code::LDX};
+		WHEN("It is packed into a predecoded entry")
+		{
+			const Predecoded entry{
+				make_predecoded(inst, NO_HANDLER, Op_kind::Load)
+			};
+			THEN("It takes 8 bytes, and unpacks to the same instruction")
+			{
+				REQUIRE(sizeof(entry) == 8);
+				REQUIRE(entry.kind() == Op_kind::Load);
+				REQUIRE(entry.length() == 1);
+				const Instruction unpacked{entry.instruction()};
+				REQUIRE(unpacked.address == inst.address);
+				REQUIRE(unpacked.index_spec == inst.index_spec);
+				REQUIRE(unpacked.field == inst.field);
+				REQUIRE(unpacked.modification == inst.modification);
+				REQUIRE(unpacked.op_code == inst.op_code);
+			}
+		}
+	}
+}
+
+SCENARIO("Superinstructions")
+{
+	GIVEN("Runs of instructions")
+	{
+		const Word lda{encode({100, 0, {0, 5}, 5, Op_code::LDA})};
+		const Word add{encode({101, 0, {1, 5}, 13, Op_code::ADD})};
+		const Word sub{encode({101, 0, {0, 5}, 5, Op_code::SUB})};
+		const Word sta{encode({102, 0, {0, 2}, 2, Op_code::STA})};
+		const Word ldx{encode({100, 0, {4, 5}, 37, Op_code::LDX})};
+		const Word stx{encode({103, 0, {0, 5}, 5, Op_code::STX})};
+		THEN("Runs that can't fault are fused")
+		{
+			const Word triple[]{lda, add, sta};
+			REQUIRE(Superinstructions::find(triple, 3).length == 3);
+			REQUIRE(Superinstructions::find(triple, 2).length == 0);
+			const Word difference[]{lda, sub, sta};
+			REQUIRE(Superinstructions::find(difference, 3).length == 3);
+			const Word copy[]{ldx, stx, lda};
+			REQUIRE(Superinstructions::find(copy, 3).length == 2);
+		}
+		THEN("Runs that may fault are not fused")
+		{
+			const Word indexed[]{
+				encode({100, 1, {0, 5}, 5, Op_code::LDA}), add, sta
+			};
+			REQUIRE(Superinstructions::find(indexed, 3).handler
+					== NO_HANDLER);
+			const Word outside[]{
+				lda, encode({4000, 0, {0, 5}, 5, Op_code::ADD}), sta
+			};
+			REQUIRE(Superinstructions::find(outside, 3).handler
+					== NO_HANDLER);
+		}
+	}
+	GIVEN("A program made of fusable runs")
+	{
+		Machine machine{}, stepped{};
+		for (Machine* m : {&machine, &stepped}) {
+			m->memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+			m->memory_cell(1, encode({101, 0, {0, 5}, 5, Op_code::ADD}));
+			m->memory_cell(2, encode({102, 0, {0, 5}, 5, Op_code::STA}));
+			m->memory_cell(3, encode({102, 0, {4, 5}, 37, Op_code::LDX}));
+			m->memory_cell(4, encode({103, 0, {0, 5}, 5, Op_code::STX}));
+			m->memory_cell(5, encode({101, 0, {0, 5}, 5, Op_code::LDA}));
+			m->memory_cell(6, encode({100, 0, {0, 5}, 5, Op_code::SUB}));
+			m->memory_cell(7, encode({104, 0, {1, 5}, 13, Op_code::STA}));
+			m->memory_cell(100, Word{Word::int_max()});
+			m->memory_cell(101, Word{-5});
+		}
+		WHEN("The program runs")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			for (int i = 0; i < 8; ++i)
+				stepped.execute_next_instruction();
+			THEN("It ends as when stepping one instruction at a time")
+			{
+				REQUIRE(machine.first_memory_difference(stepped)
+						== Machine::mem_size);
+				REQUIRE(machine.accumulator() == stepped.accumulator());
+				REQUIRE(machine.extension_register()
+						== stepped.extension_register());
+				REQUIRE(machine.overflow_bit() == stepped.overflow_bit());
+				REQUIRE(machine.program_counter() == 9);
+			}
+		}
+		WHEN("A fused cell is rewritten and the program runs again")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			machine.memory_cell(1, encode({101, 0, {0, 5}, 5, Op_code::SUB}));
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("The rewritten program is executed")
+			{
+				// The difference wraps around the largest word.
+				REQUIRE(machine.memory_cell(102) == Word{4});
+				REQUIRE(machine.overflow_bit() == Machine::Bit::On);
+			}
+		}
+	}
+	GIVEN("A run with an instruction loading from outside memory")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(1, encode({4000, 0, {0, 5}, 5, Op_code::ADD}));
+		machine.memory_cell(2, encode({102, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(100, Word{7});
+		WHEN("The program runs")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("It stops at the faulting instruction")
+			{
+				REQUIRE(machine.program_counter() == 2);
+				REQUIRE(machine.accumulator() == Word{7});
+				REQUIRE(machine.memory_cell(102) == Word{});
+			}
+		}
+	}
+}
+
+SCENARIO("Translated blocks")
+{
+	GIVEN("A straight-line program longer than a block")
+	{
+		Machine machine{};
+		for (int i = 0; i < 100; ++i)
+			machine.memory_cell(i, encode({200, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(200, Word{42});
+		WHEN("The program runs")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("It is translated into blocks ending at the unknown op")
+			{
+				const Block_stats& stats{machine.block_stats()};
+				REQUIRE(stats.translations == 2);
+				REQUIRE(stats.average_length() == 50.5);
+				REQUIRE(stats.hits == 0);
+				REQUIRE(machine.accumulator() == Word{42});
+				REQUIRE(machine.program_counter() == 101);
+			}
+		}
+		WHEN("The program runs twice")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("The blocks are reused, and the second one chained")
+			{
+				const Block_stats& stats{machine.block_stats()};
+				REQUIRE(stats.translations == 2);
+				REQUIRE(stats.hits == 2);
+				REQUIRE(stats.chained == 1);
+				REQUIRE(machine.program_counter() == 101);
+			}
+		}
+	}
+	GIVEN("A program writing over a later cell of its own block")
+	{
+		Machine machine{};
+		const Word ldx{encode({100, 0, {0, 5}, 5, Op_code::LDX})};
+		machine.memory_cell(0, encode({2, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(1, encode({103, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(2, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(100, Word{42});
+		machine.accumulator(ldx);
+		WHEN("The program runs")
+		{
+			try { machine.run_program(); } catch (std::invalid_argument&) {}
+			THEN("The block is invalidated and the new cell is executed")
+			{
+				REQUIRE(machine.block_stats().invalidations == 1);
+				REQUIRE(machine.memory_cell(103) == ldx);
+				REQUIRE(machine.extension_register() == Word{42});
+				REQUIRE(machine.accumulator() == ldx);
+				REQUIRE(machine.program_counter() == 4);
+			}
+		}
+	}
+}
+
+SCENARIO("Compiling hot blocks")
+{
+	GIVEN("A program run often enough to get hot")
+	{
+		Machine machine{}, interpreted{};
+		for (Machine* m : {&machine, &interpreted}) {
+			m->memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+			m->memory_cell(1, encode({101, 0, {0, 5}, 5, Op_code::ADD}));
+			m->memory_cell(2, encode({102, 0, {0, 5}, 5, Op_code::STA}));
+			m->memory_cell(3, encode({1, 0, {0, 3}, 3, Op_code::SFT}));
+			m->memory_cell(4, encode({102, 1, {4, 5}, 37, Op_code::LDX}));
+			m->memory_cell(5, encode({104, 0, {1, 3}, 11, Op_code::STX}));
+			m->memory_cell(100, Word{Word::int_max()});
+			m->memory_cell(101, Word{-5});
+			m->index_register(1, Half_word{1});
+		}
+		const int runs{JIT_THRESHOLD + 2};
+		WHEN("It runs with the JIT on")
+		{
+			machine.jit_mode(Machine::Jit_mode::On);
+			for (int i = 0; i < runs; ++i) {
+				try { machine.run_program(); }
+				catch (std::invalid_argument&) {}
+				try { interpreted.run_program(); }
+				catch (std::invalid_argument&) {}
+			}
+			THEN("Hot blocks run native code, with the interpreter's results")
+			{
+				REQUIRE(machine.block_stats().compiled
+						== (JIT_SUPPORTED ? 1 : 0));
+				REQUIRE(machine.first_memory_difference(interpreted)
+						== Machine::mem_size);
+				REQUIRE(machine.accumulator() == interpreted.accumulator());
+				REQUIRE(machine.extension_register()
+						== interpreted.extension_register());
+				REQUIRE(machine.program_counter() == 7);
+			}
+		}
+		WHEN("It runs with the JIT in differential mode")
+		{
+			machine.jit_mode(Machine::Jit_mode::Differential);
+			THEN("Native runs match the interpreter")
+			{
+				for (int i = 0; i < runs; ++i) {
+					try { machine.run_program(); }
+					catch (std::invalid_argument&) {}
+				}
+				REQUIRE(machine.program_counter() == 7);
+			}
+		}
+	}
+	GIVEN("A hot block with an instruction loading from outside memory")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(1, encode({4000, 0, {0, 5}, 5, Op_code::ADD}));
+		machine.memory_cell(2, encode({102, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(100, Word{7});
+		machine.jit_mode(Machine::Jit_mode::Differential);
+		WHEN("The program runs")
+		{
+			for (int i = 0; i < JIT_THRESHOLD + 2; ++i) {
+				try { machine.run_program(); }
+				catch (std::invalid_argument&) {}
+			}
+			THEN("Native code stops at the faulting instruction")
+			{
+				REQUIRE(machine.program_counter() == 2);
+				REQUIRE(machine.accumulator() == Word{7});
+				REQUIRE(machine.memory_cell(102) == Word{});
+			}
+		}
+	}
+	GIVEN("A hot program replaced by loading another one")
+	{
+		Machine machine{}, interpreted{};
+		machine.jit_mode(Machine::Jit_mode::On);
+		std::stringstream first{};
+		first << encode({100, 0, {0, 5}, 5, Op_code::LDA})
+			  << encode({101, 0, {0, 5}, 5, Op_code::STA})
+			  << Word{};
+		machine.load_program(&first);
+		machine.memory_cell(100, Word{42});
+		for (int i = 0; i < 10; ++i) {
+			try { machine.run_program(); }
+			catch (std::invalid_argument&) {}
+		}
+		WHEN("The new program runs")
+		{
+			for (Machine* m : {&machine, &interpreted}) {
+				std::stringstream second{};
+				second << encode({100, 0, {0, 5}, 5, Op_code::LDX})
+					   << encode({102, 0, {0, 5}, 5, Op_code::STX})
+					   << encode({103, 0, {0, 5}, 5, Op_code::STX})
+					   << Word{};
+				m->load_program(&second);
+				m->memory_cell(100, Word{7});
+				for (int i = 0; i < JIT_THRESHOLD + 2; ++i) {
+					try { m->run_program(); }
+					catch (std::invalid_argument&) {}
+				}
+			}
+			THEN("It runs its own code, not the old program's native code")
+			{
+				REQUIRE(machine.first_memory_difference(interpreted)
+						== Machine::mem_size);
+				REQUIRE(machine.extension_register() == Word{7});
+				REQUIRE(machine.program_counter()
+						== interpreted.program_counter());
+			}
+		}
+	}
+	GIVEN("A program rewriting its own block on every run")
+	{
+		Machine machine{};
+		const Word ldx{encode({100, 0, {0, 5}, 5, Op_code::LDX})};
+		machine.memory_cell(0, encode({2, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(1, encode({103, 0, {0, 5}, 5, Op_code::STA}));
+		machine.memory_cell(2, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(100, Word{42});
+		machine.accumulator(ldx);
+		machine.jit_mode(Machine::Jit_mode::On);
+		WHEN("The program runs")
+		{
+			for (int i = 0; i < JIT_THRESHOLD + 2; ++i) {
+				try { machine.run_program(); }
+				catch (std::invalid_argument&) {}
+			}
+			THEN("It stays interpreted")
+			{
+				REQUIRE(machine.block_stats().compiled == 0);
+				REQUIRE(machine.extension_register() == Word{42});
+				REQUIRE(machine.program_counter() == 4);
+			}
+		}
+	}
+}
+
+SCENARIO("Running translated programs")
+{
+	GIVEN("A program whose first cell is translated")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(1, encode({100, 0, {0, 5}, 5, Op_code::LDX}));
+		machine.memory_cell(100, Word{42});
+		const Translated_program translation{
+			[](Machine& m, int& next) {
+				next = 1;
+				m.accumulator(m.memory_content(100, Field_spec{0, 5}));
+			}
+		};
+		WHEN("The translation runs")
+		{
+			try { machine.run_program(translation); }
+			catch (std::invalid_argument&) {}
+			THEN("The interpreter takes over where it returns")
+			{
+				REQUIRE(machine.accumulator() == Word{42});
+				REQUIRE(machine.extension_register() == Word{42});
+				REQUIRE(machine.program_counter() == 3);
+			}
+		}
+	}
+	GIVEN("A translation that throws")
+	{
+		Machine machine{};
+		const Translated_program translation{
+			[](Machine& m, int& next) {
+				next = 1;
+				m.memory_content(-1, Field_spec{0, 5});
+			}
+		};
+		WHEN("It runs")
+		{
+			THEN("The program counter is at the cell following the fault")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.run_program(translation),
+									  std::invalid_argument);
+				}
+				else {
+					machine.run_program(translation);
+					REQUIRE(machine.fault() == Machine::Fault::Address);
+				}
+				REQUIRE(machine.program_counter() == 1);
+			}
+		}
+	}
+}
+
+SCENARIO("Trapping bad addresses")
+{
+	GIVEN("A mix machine with an instruction loading from outside memory")
+	{
+		Machine machine{};
+		const Word inst{encode({4000, 0, {0, 5}, 5, Op_code::LDA})};
+		machine.memory_cell(0, inst);
+		machine.accumulator({Sign::Minus, {1, 2, 3, 4, 5}});
+		WHEN("The instruction is executed")
+		{
+			THEN("The checked engine throws, the unchecked engine faults")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.execute_next_instruction(),
+									  std::invalid_argument);
+				}
+				else {
+					machine.execute_next_instruction();
+					REQUIRE(machine.fault() == Machine::Fault::Address);
+					REQUIRE(machine.accumulator() == Word{});
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Trapping unknown op codes")
+{
+	GIVEN("A mix machine with an instruction whose op code has no operation")
+	{
+		Machine machine{};
+		machine.memory_cell(0, {Sign::Plus, {0, 1, 0, 5, 63}});
+		WHEN("The instruction is executed")
+		{
+			THEN("The checked engine throws, the unchecked engine faults")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.execute_next_instruction(),
+									  std::invalid_argument);
+					machine.program_counter(0);
+					std::string message{};
+					try { machine.execute_next_instruction(); }
+					catch (std::invalid_argument& e) { message = e.what(); }
+					REQUIRE(message == "Unknown op code: 63");
+				}
+				else {
+					machine.execute_next_instruction();
+					REQUIRE(machine.fault() == Machine::Fault::Op_code);
+				}
+			}
+		}
+	}
+	GIVEN("The op code dispatch table")
+	{
+		const Handler unknown{Op_table::execute_unknown};
+		THEN("Op codes without an operation get the fault entry")
+		{
+			REQUIRE(Op_table::handler(Op_code::ADD) != unknown);
+			REQUIRE(Op_table::handler(Op_code::STZ) != unknown);
+			REQUIRE(Op_table::handler(static_cast<Op_code>(0)) == unknown);
+			REQUIRE(Op_table::handler(static_cast<Op_code>(INVALID_BYTE))
+					== unknown);
+		}
+	}
+}
+
+SCENARIO("Trapping instructions that don't decode")
+{
+	GIVEN("A program loading an invalid field, LDA 10(5:1)")
+	{
+		Machine machine{};
+		machine.memory_cell(0, {Sign::Plus, {0, 10, 0, 41, Op_code::LDA}});
+		WHEN("It runs")
+		{
+			THEN("The checked engine throws, the unchecked engine faults")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.run_program(),
+									  std::invalid_argument);
+				}
+				else {
+					machine.run_program();
+					REQUIRE(machine.fault() == Machine::Fault::Field);
+				}
+				REQUIRE(machine.program_counter() == 1);
+			}
+		}
+	}
+	GIVEN("A program whose second instruction has an invalid sign")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({100, 0, {0, 5}, 5, Op_code::LDA}));
+		machine.memory_cell(1, {Sign::Invalid, {0, 100, 0, 5, Op_code::STA}});
+		machine.memory_cell(100, Word{42});
+		WHEN("It runs")
+		{
+			THEN("The checked engine throws, the unchecked engine faults")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.run_program(),
+									  std::invalid_argument);
+				}
+				else {
+					machine.run_program();
+					REQUIRE(machine.fault() == Machine::Fault::Word);
+				}
+				REQUIRE(machine.accumulator() == Word{42});
+				REQUIRE(machine.program_counter() == 2);
+			}
+		}
+	}
+}
+
+SCENARIO("Trapping negative shift amounts")
+{
+	GIVEN("A program shifting rA:rX left by -3 bytes, SLAX -3")
+	{
+		Machine machine{};
+		machine.memory_cell(0, encode({-3, 0, {0, 2}, 2, Op_code::SFT}));
+		machine.accumulator({Sign::Plus, {1, 2, 3, 4, 5}});
+		WHEN("It runs")
+		{
+			THEN("The checked engine throws, the unchecked engine faults")
+			{
+				if (CHECKED_ACCESS) {
+					REQUIRE_THROWS_AS(machine.run_program(),
+									  std::invalid_argument);
+				}
+				else {
+					machine.run_program();
+					REQUIRE(machine.fault() == Machine::Fault::Shift);
+				}
+				require_bytes_are(machine.accumulator(), {1, 2, 3, 4, 5});
+				REQUIRE(machine.program_counter() == 1);
 			}
 		}
 	}
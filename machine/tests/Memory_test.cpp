@@ -0,0 +1,284 @@
+#include "catch.hpp"
+#include "../Memory.h"
+#include "../Paged_memory.h"
+#ifndef MIX_DECIMAL
+#include "../Split_memory.h"
+#endif
+#include "../Word.h"
+#include <string>
+
+using namespace mix;
+
+// All layouts must behave identically behind the same cell API.
+// Sizes that aren't a multiple of the scan block size cover the tail.
+// Split memory only holds binary words, so decimal builds skip its own
+// scenario and check the flat layout in its place.
+using Words = Basic_memory<130>;
+#ifdef MIX_DECIMAL
+using Split = Basic_memory<130>;
+#else
+using Split = Basic_split_memory<130>;
+#endif
+using Paged = Basic_paged_memory<130, 64>;
+
+#ifndef MIX_DECIMAL
+SCENARIO("Split memory cells")
+{
+	GIVEN("A split memory")
+	{
+		Split memory{};
+		THEN("All cells are +0")
+		{
+			for (int i = 0; i < 130; ++i)
+				REQUIRE(memory[i] == Word{});
+		}
+		WHEN("Words are written through the cell references")
+		{
+			const Word negative{Sign::Minus, {1, 2, 3, 4, 5}};
+			const Word positive{Sign::Plus, {63, 0, 63, 0, 63}};
+			memory[0] = negative;
+			memory[129] = positive;
+			memory[64] = memory[0];
+			THEN("They read back unchanged")
+			{
+				REQUIRE(memory[0] == negative);
+				REQUIRE(memory[64] == negative);
+				REQUIRE(memory[129] == positive);
+				REQUIRE(memory[1] == Word{});
+			}
+			AND_WHEN("A negative cell is overwritten with a positive word")
+			{
+				memory[0] = positive;
+				THEN("Its sign bit is cleared")
+				{
+					REQUIRE(memory[0] == positive);
+				}
+			}
+			AND_WHEN("Memory is cleared")
+			{
+				memory.clear();
+				THEN("All cells are +0")
+				{
+					REQUIRE(memory[0] == Word{});
+					REQUIRE(memory[129] == Word{});
+				}
+			}
+		}
+		WHEN("An invalid word is written")
+		{
+			memory[3] = Word{Sign::Invalid, {1, 2, 3, 4, 5}};
+			THEN("It reads back with an invalid sign and invalid bytes")
+			{
+				const Word w{memory[3]};
+				REQUIRE(w.is_valid() == false);
+				REQUIRE(w.sign() == Sign::Invalid);
+				REQUIRE(w.byte(1) == INVALID_BYTE);
+			}
+		}
+	}
+}
+#endif
+
+SCENARIO("Scanning memory for invalid words")
+{
+	GIVEN("Both memory layouts with one invalid word")
+	{
+		Words words{};
+		Split split{};
+		Word invalid{};
+		invalid.byte(2) = 100;
+		words[100] = invalid;
+		split[100] = invalid;
+		THEN("A scan of a valid range finds nothing")
+		{
+			REQUIRE(words.first_invalid(0, 100) == 100);
+			REQUIRE(split.first_invalid(0, 100) == 100);
+		}
+		THEN("A scan over the word finds it")
+		{
+			REQUIRE(words.first_invalid(0, 130) == 100);
+			REQUIRE(split.first_invalid(0, 130) == 100);
+			REQUIRE(words.first_invalid(100, 101) == 100);
+			REQUIRE(split.first_invalid(100, 101) == 100);
+		}
+	}
+}
+
+SCENARIO("Comparing memories")
+{
+	GIVEN("Two identical memories of each layout")
+	{
+		Words words_a{}, words_b{};
+		Split split_a{}, split_b{};
+		THEN("There is no difference")
+		{
+			REQUIRE(words_a.first_difference(words_b) == 130);
+			REQUIRE(split_a.first_difference(split_b) == 130);
+		}
+		WHEN("Cells differ by sign only, and by magnitude")
+		{
+			words_b[70].sign() = Sign::Minus;
+			split_b[70] = Word{Sign::Minus};
+			words_b[128] = Word{5};
+			split_b[128] = Word{5};
+			THEN("Both differences are found, in address order")
+			{
+				REQUIRE(words_a.first_difference(words_b) == 70);
+				REQUIRE(split_a.first_difference(split_b) == 70);
+				REQUIRE(words_a.first_difference(words_b, 71) == 128);
+				REQUIRE(split_a.first_difference(split_b, 71) == 128);
+				REQUIRE(split_a.first_difference(split_b, 129) == 130);
+			}
+		}
+	}
+}
+
+SCENARIO("Writing a memory image")
+{
+	GIVEN("The same words in both memory layouts")
+	{
+		Words words{};
+		Split split{};
+		for (int i = 0; i < 130; ++i) {
+			const Word w{i % 2 ? -i * 1000 : i * 77};
+			words[i] = w;
+			split[i] = w;
+		}
+		WHEN("Both images are written")
+		{
+			std::string words_image(130 * WORD_IMAGE_SIZE, '\0');
+			std::string split_image(130 * WORD_IMAGE_SIZE, '\0');
+			words.write_image(&words_image[0]);
+			split.write_image(&split_image[0]);
+			THEN("The images are identical")
+			{
+				REQUIRE(words_image == split_image);
+				REQUIRE(words_image[WORD_IMAGE_SIZE] == '-');
+			}
+		}
+	}
+}
+
+SCENARIO("Paged memory pages")
+{
+	GIVEN("A paged memory and a copy of it")
+	{
+		Paged memory{};
+		memory[1] = Word{1};
+		memory[129] = Word{-129};
+		Paged copy{memory};
+		THEN("The copy shares every page")
+		{
+			REQUIRE(copy.shares_page(memory, 0));
+			REQUIRE(copy.shares_page(memory, 129));
+			REQUIRE(copy.first_difference(memory) == 130);
+		}
+		WHEN("The copy writes a cell")
+		{
+			copy[70] = Word{Sign::Minus, {1, 2, 3, 4, 5}};
+			copy.insert_field(71, Word{9}, {5, 5});
+			THEN("Only the page of the cell is copied")
+			{
+				REQUIRE(copy.shares_page(memory, 0));
+				REQUIRE(!copy.shares_page(memory, 70));
+				REQUIRE(copy.shares_page(memory, 129));
+			}
+			THEN("The original memory is unchanged")
+			{
+				REQUIRE(memory[70] == Word{});
+				REQUIRE(memory[71] == Word{});
+				REQUIRE(copy[71] == Word{9});
+				REQUIRE(copy.first_difference(memory) == 70);
+				REQUIRE(copy.first_difference(memory, 72) == 130);
+			}
+		}
+		WHEN("The copy is cleared")
+		{
+			copy.clear();
+			THEN("It reads +0 everywhere, and the original is unchanged")
+			{
+				REQUIRE(copy.first_difference(Paged{}) == 130);
+				REQUIRE(memory[129] == Word{-129});
+			}
+		}
+	}
+	GIVEN("The same words in paged and flat memories")
+	{
+		Words words{};
+		Paged paged{};
+		for (int i = 0; i < 130; ++i) {
+			const Word w{i % 2 ? -i * 1000 : i * 77};
+			words[i] = w;
+			paged[i] = w;
+		}
+		Word invalid{};
+		invalid.byte(2) = 100;
+		words[100] = invalid;
+		paged[100] = invalid;
+		THEN("Scans, images and integers agree")
+		{
+			REQUIRE(paged.first_invalid(0, 130) == 100);
+			REQUIRE(paged.first_invalid(0, 100) == 100);
+			REQUIRE(paged.first_invalid(101, 130) == 130);
+
+			std::string words_image(130 * WORD_IMAGE_SIZE, '\0');
+			std::string paged_image(130 * WORD_IMAGE_SIZE, '\0');
+			words.write_image(&words_image[0]);
+			paged.write_image(&paged_image[0]);
+			REQUIRE(words_image == paged_image);
+
+			words[100] = Word{};
+			paged[100] = Word{};
+			long long values[130];
+			words.to_ints(values);
+			Paged from_ints{};
+			from_ints.from_ints(values);
+			REQUIRE(from_ints.first_difference(paged) == 130);
+		}
+	}
+}
+
+SCENARIO("Packed memory images")
+{
+	GIVEN("The same words in every memory layout")
+	{
+		Words words{};
+		Split split{};
+		Paged paged{};
+		for (int i = 0; i < 130; i += 3) {
+			const Word w{i % 2 ? -i * 1000 : i * 77};
+			words[i] = w;
+			split[i] = w;
+			paged[i] = w;
+		}
+		WHEN("Their packed images are taken")
+		{
+			Word::Packed words_image[130], split_image[130], paged_image[130];
+			words.to_packed(words_image);
+			split.to_packed(split_image);
+			paged.to_packed(paged_image);
+			THEN("The images are identical")
+			{
+				for (int i = 0; i < 130; ++i) {
+					REQUIRE(split_image[i] == words_image[i]);
+					REQUIRE(paged_image[i] == words_image[i]);
+				}
+			}
+			AND_WHEN("Each image is read back into an empty memory")
+			{
+				Words words_copy{};
+				Split split_copy{};
+				Paged paged_copy{};
+				words_copy.from_packed(words_image);
+				split_copy.from_packed(split_image);
+				paged_copy.from_packed(paged_image);
+				THEN("The memories are restored")
+				{
+					REQUIRE(words_copy.first_difference(words) == 130);
+					REQUIRE(split_copy.first_difference(split) == 130);
+					REQUIRE(paged_copy.first_difference(paged) == 130);
+				}
+			}
+		}
+	}
+}
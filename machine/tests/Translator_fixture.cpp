@@ -0,0 +1,80 @@
+#include "../Instruction.h"
+#include "../Op_code.h"
+#include "../Word.h"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+
+using namespace mix;
+
+/*
+* Write the fixture program of the end-to-end translator test.
+* It covers inlined loads and stores, indexing, arithmetic, shifts and
+* a store into its own code, and ends at an unknown op code.
+* Parameters:
+*	path - File to write the program to.
+*/
+void write_fixture(const char* path)
+{
+	std::ofstream program{path};
+	if (!program)
+		throw std::invalid_argument{std::string{"Cannot write "} + path};
+
+	const Word code[]{
+		encode({30, 0, {0, 5}, 5, Op_code::LDA}),
+		encode({31, 0, {0, 5}, 5, Op_code::ADD}),
+		encode({40, 0, {0, 5}, 5, Op_code::STA}),
+		encode({32, 0, {0, 5}, 5, Op_code::LD1}),
+		encode({30, 1, {0, 5}, 5, Op_code::LDA}),
+		encode({33, 0, {0, 5}, 5, Op_code::SUB}),
+		encode({31, 0, {0, 5}, 5, Op_code::MUL}),
+		encode({41, 0, {0, 5}, 5, Op_code::STX}),
+		encode({1, 0, {0, 3}, 3, Op_code::SFT}),
+		encode({42, 0, {0, 5}, 5, Op_code::STA}),
+		encode({34, 0, {0, 5}, 5, Op_code::LDX}),
+		encode({43, 0, {0, 5}, 5, Op_code::STZ}),
+		encode({43, 0, {0, 5}, 5, Op_code::LDA}),
+		encode({35, 0, {0, 5}, 5, Op_code::DIV}),
+		encode({44, 0, {0, 5}, 5, Op_code::STA}),
+		encode({45, 0, {0, 5}, 5, Op_code::STX}),
+		encode({31, 0, {0, 5}, 5, Op_code::LDAN}),
+		encode({46, 0, {1, 5}, 13, Op_code::STA}),
+		encode({47, 0, {0, 5}, 5, Op_code::ST1}),
+		encode({36, 0, {0, 5}, 5, Op_code::LDA}),
+		encode({21, 0, {0, 5}, 5, Op_code::STA}),
+		// Overwritten by the store above.
+		encode({30, 0, {0, 5}, 5, Op_code::LDA})
+	};
+	const Word data[]{
+		Word{1000}, Word{-7}, Word{2}, Word{5}, Word{123456}, Word{9},
+		encode({48, 0, {0, 5}, 5, Op_code::STA})
+	};
+
+	// The cell after the code is +0, an unknown op code.
+	for (const Word& w : code)
+		program << w;
+	for (int i = sizeof(code) / sizeof(code[0]); i < 30; ++i)
+		program << Word{};
+	for (const Word& w : data)
+		program << w;
+}
+
+/*
+* Main entry point.
+* Parameters:
+*	argc - Number of command line arguments.
+*	argv - Command line arguments: the file to write the program to.
+*/
+int main(int argc, char* argv[])
+{
+	try {
+		if (argc < 2)
+			throw std::invalid_argument{"Expected an output file"};
+		write_fixture(argv[1]);
+		return 0;
+	}
+	catch (std::exception& e) {
+		std::cout << e.what() << std::endl;
+		return -1;
+	}
+}
@@ -0,0 +1,86 @@
+#include "catch.hpp"
+#include "../Instruction.h"
+#include "../Op_code.h"
+#include "../Translator.h"
+#include "../Word.h"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+using namespace mix;
+
+SCENARIO("Translating programs to C++")
+{
+	GIVEN("A straight-line program ending with an unknown op")
+	{
+		std::stringstream program{};
+		program << encode({200, 0, {0, 5}, 5, Op_code::LDA})
+				<< encode({201, 2, {1, 5}, 13, Op_code::ADD})
+				<< encode({300, 0, {0, 5}, 5, Op_code::STA})
+				<< Word{};
+		WHEN("It is translated")
+		{
+			std::stringstream output{};
+			Translator::translate(&program, &output);
+			const std::string code{output.str()};
+			THEN("The image is embedded, and run by the translation")
+			{
+				REQUIRE(code.find("Word{Sign::Plus, {0, 0, 0, 0, 0}},")
+						!= std::string::npos);
+				REQUIRE(code.find("machine.run_program(run);")
+						!= std::string::npos);
+			}
+			THEN("Loads and stores are inlined")
+			{
+				REQUIRE(code.find(
+					"m.accumulator(m.memory_content(200, Field_spec{0, 5}));")
+						!= std::string::npos);
+				REQUIRE(code.find("m.store_field(a, m.accumulator(), "
+								  "Field_spec{0, 5});")
+						!= std::string::npos);
+			}
+			THEN("Other instructions run their operation, indexed")
+			{
+				REQUIRE(code.find("Math_operation{}.execute(&m, Instruction{"
+								  "201 + get_address(m.fetch_index(2)), 2, "
+								  "Field_spec{1, 5}, 13, Op_code::ADD});")
+						!= std::string::npos);
+			}
+			THEN("The interpreter takes over at the unknown op")
+			{
+				REQUIRE(code.find("next = 3;\n}") != std::string::npos);
+			}
+		}
+	}
+	GIVEN("A program storing into its own cells")
+	{
+		std::stringstream program{};
+		program << encode({0, 1, {0, 5}, 5, Op_code::STX})
+				<< encode({1, 0, {0, 5}, 5, Op_code::STA})
+				<< encode({100, 0, {0, 5}, 5, Op_code::LDA});
+		WHEN("It is translated")
+		{
+			std::stringstream output{};
+			Translator::translate(&program, &output);
+			const std::string code{output.str()};
+			THEN("The translation returns after those stores")
+			{
+				REQUIRE(code.find("if (0 <= a && a < 3) return;")
+						!= std::string::npos);
+				REQUIRE(code.find("Field_spec{0, 5});\n\treturn;\n}")
+						!= std::string::npos);
+				REQUIRE(code.find("LDA") == std::string::npos);
+			}
+		}
+	}
+	GIVEN("An empty program")
+	{
+		std::stringstream program{};
+		std::stringstream output{};
+		THEN("It can't be translated")
+		{
+			REQUIRE_THROWS_AS(Translator::translate(&program, &output),
+							  std::invalid_argument);
+		}
+	}
+}
@@ -0,0 +1,130 @@
+#include "catch.hpp"
+#include "../Word.h"
+#include "../Word_batch.h"
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+using namespace mix;
+
+// Every kernel must agree with the single word functions.
+// Ranges that aren't a multiple of the vector width cover the tails.
+const std::vector<Batch_kernel> kernels{
+	Batch_kernel::Scalar,
+	best_batch_kernel()
+};
+
+SCENARIO("Converting ranges of words to integers")
+{
+	GIVEN("A range of positive, negative and zero words")
+	{
+		std::vector<Word> words{};
+		for (int i = 0; i < 4003; ++i)
+			words.push_back(Word{(i % 2 ? -1 : 1) * i * 268});
+		words[7] = Word{Sign::Minus};
+		words[8] = Word{Word::int_max()};
+		words[9] = Word{Word::int_min()};
+		WHEN("Converted to integers by each kernel")
+		{
+			THEN("Each integer is the word's to_int()")
+			{
+				for (Batch_kernel kernel : kernels) {
+					std::vector<long long> values(words.size());
+					to_ints(words.data(), words.data() + words.size(),
+							values.data(), kernel);
+					for (std::size_t i = 0; i < words.size(); ++i)
+						REQUIRE(values[i] == words[i].to_int());
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Converting ranges of integers to words")
+{
+	GIVEN("A range of integers that fit in a word")
+	{
+		std::vector<long long> values{};
+		for (int i = 0; i < 1001; ++i)
+			values.push_back((i % 3 ? -1 : 1) * i * 1000);
+		values[5] = Word::int_max();
+		values[6] = Word::int_min();
+		WHEN("Converted to words by each kernel")
+		{
+			THEN("Each word is the same as Basic_word(long long)")
+			{
+				for (Batch_kernel kernel : kernels) {
+					std::vector<Word> words(values.size());
+					from_ints(values.data(), values.data() + values.size(),
+							  words.data(), kernel);
+					for (std::size_t i = 0; i < values.size(); ++i)
+						REQUIRE(words[i] == Word{values[i]});
+				}
+			}
+		}
+	}
+	GIVEN("A range with integers too big for a word")
+	{
+		std::vector<long long> values(64, 12);
+		values[41] = Word::int_max() + 1;
+		values[42] = std::numeric_limits<long long>::min();
+		std::vector<Word> words(values.size());
+		WHEN("Converted to words by each kernel")
+		{
+			THEN("An invalid argument exception is thrown")
+			{
+				for (Batch_kernel kernel : kernels) {
+					REQUIRE_THROWS_AS(from_ints(values.data(),
+												values.data() + values.size(),
+												words.data(), kernel),
+									  std::invalid_argument);
+				}
+			}
+			THEN("No word is written")
+			{
+				for (Batch_kernel kernel : kernels) {
+					try {
+						from_ints(values.data(), values.data() + values.size(),
+								  words.data(), kernel);
+					}
+					catch (std::invalid_argument&) {}
+					for (const Word& w : words)
+						REQUIRE(w == Word{});
+				}
+			}
+		}
+	}
+}
+
+SCENARIO("Finding invalid words in a range")
+{
+	GIVEN("A range of valid words")
+	{
+		std::vector<Word> words(4001, Word{Sign::Minus, {1, 2, 3, 4, 5}});
+		const Word* first{words.data()};
+		const Word* last{first + words.size()};
+		THEN("No kernel finds an invalid word")
+		{
+			for (Batch_kernel kernel : kernels)
+				REQUIRE(find_invalid(first, last, kernel) == last);
+		}
+		WHEN("A byte of one word is invalid")
+		{
+			words[2999].byte(5) = INVALID_BYTE;
+			THEN("Every kernel finds that word")
+			{
+				for (Batch_kernel kernel : kernels)
+					REQUIRE(find_invalid(first, last, kernel) == first + 2999);
+			}
+		}
+		WHEN("The sign of the last word is invalid")
+		{
+			words[4000].sign() = Sign::Invalid;
+			THEN("Every kernel finds that word")
+			{
+				for (Batch_kernel kernel : kernels)
+					REQUIRE(find_invalid(first, last, kernel) == first + 4000);
+			}
+		}
+	}
+}
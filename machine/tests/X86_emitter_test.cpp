@@ -0,0 +1,135 @@
+#include "catch.hpp"
+#include "../Byte.h"
+#include "../X86_emitter.h"
+#include <vector>
+
+using namespace mix;
+
+SCENARIO("Emitting x86-64 instructions")
+{
+	GIVEN("An emitter with room to spare")
+	{
+		Byte buffer[64]{};
+		X86_emitter e{buffer, sizeof(buffer)};
+		using R = X86_emitter;
+		WHEN("Register instructions are emitted")
+		{
+			e.push(R::rbx);
+			e.push(R::r12);
+			e.mov(R::rbx, R::rdi);
+			e.call(R::rax);
+			e.pop(R::r12);
+			e.ret();
+			THEN("They are encoded with REX prefixes where needed")
+			{
+				const std::vector<Byte> expected{
+					0x53, 0x41, 0x54, 0x48, 0x89, 0xFB, 0xFF, 0xD0,
+					0x41, 0x5C, 0xC3
+				};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("Memory operands based on rbx and r14 are emitted")
+		{
+			e.lea(R::rsi, R::rbx, 0x38);
+			e.call(R::r14, 8);
+			THEN("They take a ModRM byte and a displacement")
+			{
+				const std::vector<Byte> expected{
+					0x48, 0x8D, 0xB3, 0x38, 0x00, 0x00, 0x00,
+					0x41, 0xFF, 0x56, 0x08
+				};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("A memory operand based on r12 is emitted")
+		{
+			e.lea(R::rdi, R::r12, -8);
+			THEN("It takes a SIB byte")
+			{
+				const std::vector<Byte> expected{
+					0x49, 0x8D, 0xBC, 0x24, 0xF8, 0xFF, 0xFF, 0xFF
+				};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("Loads, stores and compares to memory are emitted")
+		{
+			e.load(R::rax, R::r12, 8);
+			e.store(R::rbx, 0x10, R::rdx);
+			e.store8(R::rbx, 0x20, 1);
+			e.cmp8(R::r12, 5, 0);
+			e.cmp32(R::rdi, 4, 0);
+			THEN("They take the opcode extension in the ModRM byte")
+			{
+				const std::vector<Byte> expected{
+					0x49, 0x8B, 0x84, 0x24, 0x08, 0x00, 0x00, 0x00,
+					0x48, 0x89, 0x93, 0x10, 0x00, 0x00, 0x00,
+					0xC6, 0x83, 0x20, 0x00, 0x00, 0x00, 0x01,
+					0x41, 0x80, 0xBC, 0x24, 0x05, 0x00, 0x00, 0x00, 0x00,
+					0x83, 0xBF, 0x04, 0x00, 0x00, 0x00, 0x00
+				};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("Arithmetic and logic instructions are emitted")
+		{
+			e.alu(R::bit_and, R::rdx, R::r8);
+			e.shift(R::shr, R::rdx, 6);
+			e.neg(R::rcx);
+			e.test(R::rax, R::rax);
+			e.cmov(R::not_zero, R::rsi, R::rdi);
+			THEN("They are encoded on 64 bits")
+			{
+				const std::vector<Byte> expected{
+					0x4C, 0x21, 0xC2, 0x48, 0xC1, 0xEA, 0x06,
+					0x48, 0xF7, 0xD9, 0x48, 0x85, 0xC0,
+					0x48, 0x0F, 0x45, 0xF7
+				};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("A call to a target in reach is emitted")
+		{
+			const bool direct{e.call(buffer + sizeof(buffer))};
+			THEN("It is a direct call relative to the next instruction")
+			{
+				REQUIRE(direct);
+				const std::vector<Byte> expected{0xE8, 59, 0, 0, 0};
+				REQUIRE(std::vector<Byte>(buffer, buffer + e.size())
+						== expected);
+			}
+		}
+		WHEN("A jump is bound to a later position")
+		{
+			const int at{e.jump(R::zero)};
+			e.ret();
+			e.bind(at, e.size());
+			THEN("Its displacement is relative to the next instruction")
+			{
+				REQUIRE(buffer[0] == 0x0F);
+				REQUIRE(buffer[1] == 0x84);
+				REQUIRE(buffer[2] == 1);
+				REQUIRE(buffer[3] == 0);
+			}
+		}
+	}
+	GIVEN("An emitter without enough room")
+	{
+		Byte buffer[4]{};
+		X86_emitter e{buffer, sizeof(buffer)};
+		WHEN("An instruction longer than the room left is emitted")
+		{
+			e.mov(X86_emitter::rax, 0x1234);
+			THEN("The emitter overflows")
+			{
+				REQUIRE(e.overflowed());
+			}
+		}
+	}
+}
@@ -0,0 +1,48 @@
+#include "Translator.h"
+#include "util/console/cmd_args.h"
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*
+* Translate the program named by the first argument into the C++
+* translation unit named by the second.
+* Parameters:
+*	argc - Number of command line arguments.
+*	argv - Command line arguments.
+*/
+void run(int argc, char* argv[])
+{
+	std::vector<std::string> args{console::get_args(argc, argv)};
+	if (args.size() < 2) {
+		throw std::invalid_argument{"Expected a program and an output file"};
+	}
+
+	std::ifstream program{args[0]};
+	std::ofstream output{args[1]};
+	if (!output) {
+		throw std::invalid_argument{"Cannot write " + args[1]};
+	}
+	mix::Translator::translate(&program, &output);
+}
+
+/*
+* Main entry point.
+* Calls run() and catches exceptions.
+* Parameters:
+*	argc - Number of command line arguments.
+*	argv - Command line arguments.
+*/
+int main(int argc, char* argv[])
+{
+	try {
+		run(argc, argv);
+		return 0;
+	}
+	catch(std::exception& e) {
+		std::cout << e.what() << std::endl;
+		return -1;
+	}
+}